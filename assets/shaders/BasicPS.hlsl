@@ -0,0 +1,5 @@
+#include "Common.hlsli"
+
+float4 main(PS_INPUT input) : SV_TARGET {
+    return input.color;
+}
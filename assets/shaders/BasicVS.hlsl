@@ -0,0 +1,12 @@
+#include "Common.hlsli"
+
+cbuffer TransformBuffer : register(b0) {
+    float4x4 viewProj;
+};
+
+PS_INPUT main(VS_INPUT input) {
+    PS_INPUT output;
+    output.pos = mul(float4(input.pos, 1.0f), viewProj);
+    output.color = input.color;
+    return output;
+}
@@ -0,0 +1,14 @@
+struct VS_INPUT {
+    float3 pos : POSITION;
+    float4 color : COLOR;
+};
+
+struct PS_INPUT {
+    float4 pos : SV_POSITION;
+    float4 color : COLOR;
+};
+
+struct FULLSCREEN_OUTPUT {
+    float4 pos : SV_POSITION;
+    float2 uv : TEXCOORD;
+};
@@ -0,0 +1,15 @@
+#include "Common.hlsli"
+
+Texture2D sceneTexture : register(t0);
+SamplerState linearClamp : register(s0);
+
+cbuffer UpscaleConstants : register(b0) {
+    // Fraction of the scene texture covered by the rendered region, and the
+    // largest UV that stays half a texel inside it.
+    float2 uvScale;
+    float2 uvMax;
+};
+
+float4 main(FULLSCREEN_OUTPUT input) : SV_TARGET {
+    return sceneTexture.Sample(linearClamp, min(input.uv * uvScale, uvMax));
+}
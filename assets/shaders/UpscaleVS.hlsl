@@ -0,0 +1,9 @@
+#include "Common.hlsli"
+
+// Single triangle covering the whole viewport, generated from the vertex ID.
+FULLSCREEN_OUTPUT main(uint id : SV_VertexID) {
+    FULLSCREEN_OUTPUT output;
+    output.uv = float2((id << 1) & 2, id & 2);
+    output.pos = float4(output.uv * float2(2.0f, -2.0f) + float2(-1.0f, 1.0f), 0.0f, 1.0f);
+    return output;
+}
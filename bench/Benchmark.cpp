@@ -0,0 +1,331 @@
+#include "Benchmark.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    constexpr double MinSampleNanoseconds = 10.0e6;
+    volatile uint64_t g_sink = 0;
+
+    using Clock = std::chrono::steady_clock;
+
+    double TimeRuns(const std::function<void()>& body, uint64_t runs) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < runs; ++i) {
+            body();
+        }
+        return static_cast<double>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+    }
+
+    std::string Escape(const std::string& text) {
+        std::string escaped;
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                escaped += '\\';
+            }
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    // Just enough JSON to read back the files WriteResultsJson produces (and
+    // hand edits of them): objects, arrays, strings, numbers and literals.
+    class JsonReader {
+    public:
+        explicit JsonReader(const std::string& text) : m_text(text), m_pos(0) {}
+
+        bool ReadResults(std::vector<BenchmarkResult>& results, double& defaultTolerance) {
+            bool parsed = ParseObject([&](const std::string& key) {
+                if (key == "tolerance") {
+                    return ParseNumber(defaultTolerance);
+                }
+                if (key == "benchmarks") {
+                    return ParseArray([&]() {
+                        BenchmarkResult result = {};
+                        result.tolerance = -1.0;
+                        if (!ParseObject([&](const std::string& field) {
+                            return ReadField(field, result);
+                        })) {
+                            return false;
+                        }
+                        results.push_back(result);
+                        return true;
+                    });
+                }
+                return SkipValue();
+            });
+            SkipWhitespace();
+            return parsed && m_pos == m_text.size();
+        }
+
+    private:
+        bool ReadField(const std::string& field, BenchmarkResult& result) {
+            double number = 0.0;
+            if (field == "name") {
+                return ParseString(result.name);
+            } else if (field == "items") {
+                bool ok = ParseNumber(number);
+                result.items = static_cast<uint64_t>(number);
+                return ok;
+            } else if (field == "ns_per_item") {
+                return ParseNumber(result.nsPerItem);
+            } else if (field == "min_ns_per_item") {
+                return ParseNumber(result.minNsPerItem);
+            } else if (field == "tolerance") {
+                return ParseNumber(result.tolerance);
+            }
+            return SkipValue();
+        }
+
+        void SkipWhitespace() {
+            while (m_pos < m_text.size() && std::isspace(static_cast<unsigned char>(m_text[m_pos]))) {
+                ++m_pos;
+            }
+        }
+
+        bool Expect(char c) {
+            SkipWhitespace();
+            if (m_pos < m_text.size() && m_text[m_pos] == c) {
+                ++m_pos;
+                return true;
+            }
+            return false;
+        }
+
+        bool Peek(char c) {
+            SkipWhitespace();
+            return m_pos < m_text.size() && m_text[m_pos] == c;
+        }
+
+        bool ParseString(std::string& value) {
+            if (!Expect('"')) {
+                return false;
+            }
+            value.clear();
+            while (m_pos < m_text.size() && m_text[m_pos] != '"') {
+                if (m_text[m_pos] == '\\' && m_pos + 1 < m_text.size()) {
+                    ++m_pos;
+                }
+                value += m_text[m_pos++];
+            }
+            return Expect('"');
+        }
+
+        bool ParseNumber(double& value) {
+            SkipWhitespace();
+            const char* begin = m_text.c_str() + m_pos;
+            char* end = nullptr;
+            value = std::strtod(begin, &end);
+            if (end == begin) {
+                return false;
+            }
+            m_pos += end - begin;
+            return true;
+        }
+
+        template <typename OnKey>
+        bool ParseObject(OnKey onKey) {
+            if (!Expect('{')) {
+                return false;
+            }
+            if (Expect('}')) {
+                return true;
+            }
+            do {
+                std::string key;
+                if (!ParseString(key) || !Expect(':') || !onKey(key)) {
+                    return false;
+                }
+            } while (Expect(','));
+            return Expect('}');
+        }
+
+        template <typename OnElement>
+        bool ParseArray(OnElement onElement) {
+            if (!Expect('[')) {
+                return false;
+            }
+            if (Expect(']')) {
+                return true;
+            }
+            do {
+                if (!onElement()) {
+                    return false;
+                }
+            } while (Expect(','));
+            return Expect(']');
+        }
+
+        bool SkipValue() {
+            if (Peek('{')) {
+                return ParseObject([this](const std::string&) { return SkipValue(); });
+            }
+            if (Peek('[')) {
+                return ParseArray([this]() { return SkipValue(); });
+            }
+            if (Peek('"')) {
+                std::string ignored;
+                return ParseString(ignored);
+            }
+            for (const char* literal : { "true", "false", "null" }) {
+                size_t length = std::char_traits<char>::length(literal);
+                if (m_text.compare(m_pos, length, literal) == 0) {
+                    m_pos += length;
+                    return true;
+                }
+            }
+            double ignored = 0.0;
+            return ParseNumber(ignored);
+        }
+
+        const std::string& m_text;
+        size_t m_pos;
+    };
+}
+
+BenchmarkRunner::BenchmarkRunner(uint32_t samples, const std::string& filter)
+    : m_samples(std::max(1u, samples)), m_filter(filter) {}
+
+bool MatchesFilter(const std::string& name, const std::string& filter) {
+    return filter.empty() || name.find(filter) != std::string::npos;
+}
+
+bool BenchmarkRunner::Run(const std::string& name, uint64_t itemsPerRun, const std::function<void()>& body,
+    double tolerance) {
+    if (!MatchesFilter(name, m_filter)) {
+        return false;
+    }
+
+    // The first call doubles as warm-up (page faults, thread creation,
+    // lazily grown buffers) and as the calibration estimate.
+    double single = std::max(1.0, TimeRuns(body, 1));
+    uint64_t runs = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(MinSampleNanoseconds / single)));
+
+    std::vector<double> samples;
+    samples.reserve(m_samples);
+    for (uint32_t i = 0; i < m_samples; ++i) {
+        samples.push_back(TimeRuns(body, runs) / static_cast<double>(runs * std::max<uint64_t>(1, itemsPerRun)));
+    }
+    std::sort(samples.begin(), samples.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.items = itemsPerRun;
+    result.nsPerItem = samples[samples.size() / 2];
+    result.minNsPerItem = samples.front();
+    result.tolerance = tolerance;
+    m_results.push_back(result);
+
+    std::printf("%-48s %12.3f ns/item  (min %.3f, %llu items x %llu runs)\n", name.c_str(),
+        result.nsPerItem, result.minNsPerItem, static_cast<unsigned long long>(itemsPerRun),
+        static_cast<unsigned long long>(runs));
+    std::fflush(stdout);
+    return true;
+}
+
+void Consume(uint64_t value) {
+    g_sink = g_sink + value;
+}
+
+bool WriteResultsJson(const std::string& path, const std::vector<BenchmarkResult>& results,
+    double defaultTolerance) {
+    std::ofstream file(path, std::ios::trunc);
+    if (!file) {
+        std::cerr << "Failed to write " << path << "\n";
+        return false;
+    }
+
+    file.precision(6);
+    file << std::fixed;
+    file << "{\n";
+    file << "  \"tolerance\": " << defaultTolerance << ",\n";
+    file << "  \"benchmarks\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& result = results[i];
+        file << "    { \"name\": \"" << Escape(result.name) << "\", \"items\": " << result.items
+            << ", \"ns_per_item\": " << result.nsPerItem
+            << ", \"min_ns_per_item\": " << result.minNsPerItem;
+        if (result.tolerance >= 0.0) {
+            file << ", \"tolerance\": " << result.tolerance;
+        }
+        file << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    file << "  ]\n";
+    file << "}\n";
+    return static_cast<bool>(file);
+}
+
+bool LoadResultsJson(const std::string& path, std::vector<BenchmarkResult>& results,
+    double& defaultTolerance) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Failed to open " << path << "\n";
+        return false;
+    }
+
+    std::stringstream contents;
+    contents << file.rdbuf();
+    std::string text = contents.str();
+
+    results.clear();
+    JsonReader reader(text);
+    if (!reader.ReadResults(results, defaultTolerance)) {
+        std::cerr << "Malformed benchmark file " << path << "\n";
+        return false;
+    }
+    return true;
+}
+
+bool CompareWithBaseline(const std::vector<BenchmarkResult>& results,
+    const std::vector<BenchmarkResult>& baseline, double defaultTolerance, const std::string& filter) {
+    bool passed = true;
+    uint32_t compared = 0;
+    uint32_t missing = 0;
+
+    std::printf("\n%-48s %12s %12s %8s %8s\n", "benchmark", "baseline", "current", "ratio", "limit");
+    for (const BenchmarkResult& expected : baseline) {
+        auto current = std::find_if(results.begin(), results.end(),
+            [&expected](const BenchmarkResult& result) { return result.name == expected.name; });
+        if (current == results.end()) {
+            if (MatchesFilter(expected.name, filter)) {
+                std::printf("%-48s %12.3f %12s  MISSING\n", expected.name.c_str(), expected.nsPerItem, "-");
+                passed = false;
+                ++missing;
+            }
+            continue;
+        }
+
+        double tolerance = expected.tolerance >= 0.0 ? expected.tolerance : defaultTolerance;
+        double ratio = current->nsPerItem / std::max(expected.nsPerItem, 1e-9);
+        double limit = 1.0 + tolerance;
+        const char* verdict = "";
+        if (ratio > limit) {
+            verdict = "  REGRESSION";
+            passed = false;
+        } else if (ratio < 1.0 / limit) {
+            verdict = "  faster (consider updating the baseline)";
+        }
+
+        std::printf("%-48s %12.3f %12.3f %7.2fx %7.2fx%s\n", expected.name.c_str(),
+            expected.nsPerItem, current->nsPerItem, ratio, limit, verdict);
+        ++compared;
+    }
+
+    for (const BenchmarkResult& result : results) {
+        bool known = std::any_of(baseline.begin(), baseline.end(),
+            [&result](const BenchmarkResult& expected) { return expected.name == result.name; });
+        if (!known) {
+            std::printf("%-48s %12s %12.3f  (not in baseline)\n", result.name.c_str(), "-", result.nsPerItem);
+        }
+    }
+
+    std::printf("\n%u benchmark(s) compared, %u missing: %s\n", compared, missing, passed ? "PASS" : "FAIL");
+    return passed;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+struct BenchmarkResult {
+    std::string name;
+    uint64_t items;
+    double nsPerItem;
+    double minNsPerItem;
+    // Allowed slowdown relative to the baseline, e.g. 0.5 fails at 1.5x.
+    // Negative means "use the baseline file's default".
+    double tolerance = -1.0;
+};
+
+// Times scenario bodies. Each body is calibrated to run for at least a few
+// milliseconds per sample, then sampled a fixed number of times; the median
+// is reported, so single scheduler hiccups do not move the result.
+class BenchmarkRunner {
+public:
+    explicit BenchmarkRunner(uint32_t samples, const std::string& filter = std::string());
+
+    // itemsPerRun is what one call of body processes (meshes, allocations,
+    // draws, ...); results are normalized to nanoseconds per item.
+    // tolerance overrides the baseline default for scenarios that are noisy
+    // by nature (general-purpose heap, page faults). Returns false when
+    // the filter skipped the scenario, so callers only validate what ran.
+    bool Run(const std::string& name, uint64_t itemsPerRun, const std::function<void()>& body,
+        double tolerance = -1.0);
+
+    const std::vector<BenchmarkResult>& GetResults() const { return m_results; }
+
+private:
+    uint32_t m_samples;
+    std::string m_filter;
+    std::vector<BenchmarkResult> m_results;
+};
+
+// An empty filter matches every scenario; otherwise the name must contain it.
+bool MatchesFilter(const std::string& name, const std::string& filter);
+
+// Keeps the optimizer from discarding work whose result is otherwise unused.
+void Consume(uint64_t value);
+
+bool WriteResultsJson(const std::string& path, const std::vector<BenchmarkResult>& results,
+    double defaultTolerance);
+bool LoadResultsJson(const std::string& path, std::vector<BenchmarkResult>& results,
+    double& defaultTolerance);
+
+// Prints a comparison table and returns false if any benchmark is slower than
+// baseline * (1 + tolerance), or if a baseline entry selected by filter has no
+// result (a scenario was renamed or removed without updating the baseline).
+bool CompareWithBaseline(const std::vector<BenchmarkResult>& results,
+    const std::vector<BenchmarkResult>& baseline, double defaultTolerance,
+    const std::string& filter = std::string());
@@ -0,0 +1,563 @@
+#include "Benchmark.h"
+#include "Culling.h"
+#include "FrameCapture.h"
+#include "GeometryGenerators.h"
+#include "IndirectDraw.h"
+#include "InputManager.h"
+#include "Memory.h"
+#include "NullBackend.h"
+#include "Parallel.h"
+#include "RangeAllocator.h"
+#include "ResidencyManager.h"
+#include "Transform.h"
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Scenario benchmarks for the portable engine code. Every scenario is
+// seeded and sized by its name (n = meshes or items, t = worker threads), so
+// runs on the same machine are comparable and results can be checked against
+// bench/baseline.json.
+namespace {
+    constexpr uint32_t Seed = 20240601;
+    constexpr uint32_t SceneMeshes = 16384;
+    constexpr uint32_t SubmitMeshes = 4096;
+    constexpr uint32_t Allocations = 16384;
+    constexpr uint32_t AllocationSize = 64;
+    constexpr uint32_t ThreadCounts[] = { 1, 4 };
+    // Allowed slowdown for scenarios dominated by the OS (the system heap,
+    // first-touch page faults) rather than engine code.
+    constexpr double NoisyTolerance = 1.0;
+
+    constexpr uint32_t VertexBufferId = 0;
+    constexpr uint32_t IndexBufferId = 1;
+    constexpr uint32_t ArgumentBufferId = 2;
+    constexpr uint32_t CountBufferId = 3;
+    constexpr uint32_t IndexFormatR32Uint = 42;
+
+    bool g_valid = true;
+
+    void Check(bool condition, const char* message) {
+        if (!condition) {
+            std::cerr << "Validation failed: " << message << "\n";
+            g_valid = false;
+        }
+    }
+
+    std::string Name(const char* scenario, uint32_t items, uint32_t threads = 0) {
+        std::string name = scenario;
+        name += "/n=" + std::to_string(items);
+        if (threads != 0) {
+            name += "/t=" + std::to_string(threads);
+        }
+        return name;
+    }
+
+    // N unit cubes scattered through a box in front of the camera, roughly
+    // a third of which fall inside the view frustum.
+    struct Scene {
+        std::vector<Transform> transforms;
+        std::vector<Float4x4> world;
+        std::vector<BoundingSphere> bounds;
+        std::vector<uint8_t> visibility;
+        std::vector<IndirectDrawCommand> commands;
+        std::vector<IndirectDrawCommand> compacted;
+        Frustum frustum;
+    };
+
+    Scene BuildScene(uint32_t meshCount) {
+        std::mt19937 random(Seed);
+        std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+
+        Scene scene;
+        scene.transforms.resize(meshCount);
+        for (auto& transform : scene.transforms) {
+            float s = scale(random);
+            transform.position = { position(random), position(random), position(random) };
+            transform.rotation = { angle(random), angle(random), angle(random) };
+            transform.scale = { s, s, s };
+        }
+
+        scene.world.resize(meshCount);
+        ComposeWorldMatrices(scene.transforms.data(), meshCount, scene.world.data());
+
+        BoundingSphere local = ComputeBoundingSphere(UnitCube.GetView());
+        scene.bounds.resize(meshCount);
+        for (uint32_t i = 0; i < meshCount; ++i) {
+            scene.bounds[i] = TransformSphere(local, scene.world[i]);
+        }
+
+        Float4x4 view = MakeLookAtLH({ 0.0f, 0.0f, -120.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+        Float4x4 projection = MakePerspectiveFovLH(1.0471976f, 16.0f / 9.0f, 0.1f, 400.0f);
+        scene.frustum = ExtractFrustum(Multiply(view, projection));
+
+        scene.visibility.resize(meshCount);
+        scene.commands.resize(meshCount);
+        scene.compacted.resize(meshCount);
+        for (uint32_t i = 0; i < meshCount; ++i) {
+            IndirectDrawCommand& command = scene.commands[i];
+            command = {};
+            command.draw = { static_cast<uint32_t>(UnitCube.indices.size()), 1, 0, 0, 0 };
+        }
+        return scene;
+    }
+
+    void BenchTransforms(BenchmarkRunner& runner) {
+        Scene scene = BuildScene(SceneMeshes);
+        for (uint32_t threads : ThreadCounts) {
+            SetWorkerCount(threads);
+            runner.Run(Name("transform/compose", SceneMeshes, threads), SceneMeshes, [&scene]() {
+                ComposeWorldMatrices(scene.transforms.data(), SceneMeshes, scene.world.data());
+                Consume(static_cast<uint64_t>(scene.world[SceneMeshes - 1].m[3][0]));
+            });
+        }
+        SetWorkerCount(0);
+    }
+
+    void BenchCulling(BenchmarkRunner& runner) {
+        Scene scene = BuildScene(SceneMeshes);
+        uint32_t expectedVisible = 0;
+        for (uint32_t i = 0; i < SceneMeshes; ++i) {
+            expectedVisible += IsSphereVisible(scene.frustum, scene.bounds[i]) ? 1 : 0;
+        }
+        Check(expectedVisible > 0 && expectedVisible < SceneMeshes, "scene is partially visible");
+        // The culling math itself is covered by the Culling tests; this only
+        // checks that splitting the work across workers changes nothing.
+
+        for (uint32_t threads : ThreadCounts) {
+            SetWorkerCount(threads);
+            uint32_t visible = 0;
+            uint32_t written = 0;
+            bool ran = runner.Run(Name("culling/frustum_compact", SceneMeshes, threads), SceneMeshes, [&]() {
+                visible = CullSpheres(scene.frustum, scene.bounds.data(), SceneMeshes, scene.visibility.data());
+                written = CompactDrawCommands(scene.commands.data(), scene.visibility.data(), SceneMeshes,
+                    scene.compacted.data());
+                Consume(written);
+            });
+            if (ran) {
+                Check(visible == expectedVisible && written == expectedVisible, "parallel culling matches serial pass");
+            }
+        }
+        SetWorkerCount(0);
+    }
+
+    void CreateSubmitBuffers(NullBackend& backend, uint32_t maxDraws) {
+        BufferDesc vertexDesc = { VertexBufferId, BufferUsage::Vertex, sizeof(UnitCube.vertices),
+            0x10000000, sizeof(Vertex), 0 };
+        BufferDesc indexDesc = { IndexBufferId, BufferUsage::Index, sizeof(UnitCube.indices),
+            0x20000000, sizeof(uint32_t), IndexFormatR32Uint };
+        BufferDesc argumentDesc = { ArgumentBufferId, BufferUsage::IndirectArguments,
+            sizeof(IndirectDrawCommand) * maxDraws, 0x30000000, sizeof(IndirectDrawCommand), 0 };
+        BufferDesc countDesc = { CountBufferId, BufferUsage::IndirectCount, sizeof(uint32_t), 0x40000000, 0, 0 };
+
+        backend.CreateBuffer(argumentDesc);
+        backend.CreateBuffer(countDesc);
+        backend.CreateBuffer(vertexDesc);
+        backend.CreateBuffer(indexDesc);
+        backend.UploadBuffer(VertexBufferId, 0, UnitCube.vertices.data(), sizeof(UnitCube.vertices));
+        backend.UploadBuffer(IndexBufferId, 0, UnitCube.indices.data(), sizeof(UnitCube.indices));
+    }
+
+    // Each path is timed twice: with NullBackend validating every index, and
+    // with validation off so only recording and submission are measured.
+    void BenchDirectSubmission(BenchmarkRunner& runner, const Scene& scene, bool validate) {
+        NullBackend direct;
+        direct.SetValidation(validate);
+        CreateSubmitBuffers(direct, SubmitMeshes);
+        ICommandBackend& directBackend = direct;
+        bool ran = runner.Run(Name(validate ? "submit/direct" : "submit/direct_unvalidated", SubmitMeshes),
+            SubmitMeshes, [&]() {
+            for (const IndirectDrawCommand& command : scene.commands) {
+                directBackend.DrawIndexed(command.draw);
+            }
+        });
+        if (ran) {
+            Check(direct.GetCounters().invalidCommands == 0, "direct draws validate");
+            Check(direct.GetCounters().drawCalls > 0, "direct draws executed");
+        }
+    }
+
+    void BenchIndirectSubmission(BenchmarkRunner& runner, const Scene& scene, bool validate) {
+        NullBackend indirect;
+        indirect.SetValidation(validate);
+        CreateSubmitBuffers(indirect, SubmitMeshes);
+        ICommandBackend& indirectBackend = indirect;
+        std::vector<IndirectDrawCommand> arguments(SubmitMeshes);
+        IndirectArgumentPacker packer;
+        uint32_t count = 0;
+        bool ran = runner.Run(Name(validate ? "submit/indirect_pack" : "submit/indirect_pack_unvalidated",
+            SubmitMeshes), SubmitMeshes, [&]() {
+            packer.Begin(arguments.data(), SubmitMeshes);
+            for (const IndirectDrawCommand& command : scene.commands) {
+                packer.Push(command);
+            }
+            packer.Finish(&count);
+            indirectBackend.UploadBuffer(ArgumentBufferId, 0, arguments.data(),
+                count * static_cast<uint32_t>(sizeof(IndirectDrawCommand)));
+            indirectBackend.UploadBuffer(CountBufferId, 0, &count, sizeof(count));
+            indirectBackend.ExecuteIndirect(ArgumentBufferId, CountBufferId, count);
+        });
+        if (ran) {
+            Check(count == SubmitMeshes, "every draw packed");
+            Check(indirect.GetCounters().invalidCommands == 0, "indirect draws validate");
+            Check(indirect.GetCounters().drawCalls > 0, "indirect draws executed");
+        }
+    }
+
+    void BenchSubmission(BenchmarkRunner& runner) {
+        Scene scene = BuildScene(SubmitMeshes);
+        for (bool validate : { true, false }) {
+            BenchDirectSubmission(runner, scene, validate);
+            BenchIndirectSubmission(runner, scene, validate);
+        }
+    }
+
+    void BenchAllocators(BenchmarkRunner& runner) {
+        std::vector<void*> blocks(Allocations);
+
+        runner.Run(Name("alloc/heap", Allocations), Allocations, [&blocks]() {
+            for (auto& block : blocks) {
+                block = ::operator new(AllocationSize);
+            }
+            for (auto block : blocks) {
+                ::operator delete(block);
+            }
+        }, NoisyTolerance);
+
+        LinearArena arena(static_cast<size_t>(Allocations) * AllocationSize, MemoryTag::Scratch);
+        bool ran = runner.Run(Name("alloc/arena", Allocations), Allocations, [&]() {
+            for (auto& block : blocks) {
+                block = arena.Allocate(AllocationSize, alignof(std::max_align_t));
+            }
+            Consume(blocks.back() != nullptr);
+            arena.Reset();
+        });
+        if (ran) {
+            Check(arena.GetPeak() == static_cast<size_t>(Allocations) * AllocationSize, "arena holds every block");
+        }
+
+        PoolAllocator pool(AllocationSize, Allocations, MemoryTag::Scene);
+        ran = runner.Run(Name("alloc/pool", Allocations), Allocations, [&]() {
+            for (auto& block : blocks) {
+                block = pool.Allocate();
+            }
+            for (auto block : blocks) {
+                pool.Free(block);
+            }
+        });
+        if (ran) {
+            Check(pool.GetUsedBlocks() == 0, "pool returns every block");
+        }
+    }
+
+    // The pre-generator approach: grow vectors one element at a time on a
+    // single thread. Kept here as the reference the generators are measured
+    // against.
+    MeshData CreateSpherePushBack(const SphereDesc& desc) {
+        MeshData mesh;
+        for (uint32_t stack = 0; stack <= desc.stacks; ++stack) {
+            float phi = 3.14159265f * stack / desc.stacks;
+            for (uint32_t slice = 0; slice <= desc.slices; ++slice) {
+                float theta = 6.2831853f * slice / desc.slices;
+                Vertex vertex;
+                vertex.position = { desc.radius * std::sin(phi) * std::cos(theta), desc.radius * std::cos(phi),
+                    desc.radius * std::sin(phi) * std::sin(theta) };
+                vertex.color = desc.color;
+                mesh.vertices.push_back(vertex);
+            }
+        }
+        uint32_t rowLength = desc.slices + 1;
+        for (uint32_t stack = 0; stack < desc.stacks; ++stack) {
+            for (uint32_t slice = 0; slice < desc.slices; ++slice) {
+                uint32_t a = stack * rowLength + slice;
+                mesh.indices.push_back(a);
+                mesh.indices.push_back(a + 1);
+                mesh.indices.push_back(a + rowLength + 1);
+                mesh.indices.push_back(a);
+                mesh.indices.push_back(a + rowLength + 1);
+                mesh.indices.push_back(a + rowLength);
+            }
+        }
+        return mesh;
+    }
+
+    void BenchGeometry(BenchmarkRunner& runner) {
+        SphereDesc sphere = { 1.0f, 256, 128, { 1.0f, 1.0f, 1.0f, 1.0f } };
+        uint32_t sphereVertices = GetSphereCounts(sphere.slices, sphere.stacks).vertexCount;
+
+        runner.Run(Name("geometry/sphere_push_back", sphereVertices), sphereVertices, [&sphere]() {
+            MeshData mesh = CreateSpherePushBack(sphere);
+            Consume(mesh.indices.size());
+        });
+
+        for (uint32_t threads : ThreadCounts) {
+            SetWorkerCount(threads);
+            runner.Run(Name("geometry/sphere_parallel", sphereVertices, threads), sphereVertices, [&sphere]() {
+                MeshData mesh = CreateSphere(sphere);
+                Consume(mesh.indices.size());
+            });
+        }
+        SetWorkerCount(0);
+
+        MeshData generated = CreateSphere(sphere);
+        GeometryCounts counts = GetSphereCounts(sphere.slices, sphere.stacks);
+        Check(generated.vertices.size() == counts.vertexCount && generated.indices.size() == counts.indexCount,
+            "sphere matches its reported counts");
+
+        uint32_t cubeVertices = static_cast<uint32_t>(UnitCube.vertices.size());
+        runner.Run(Name("geometry/cube_constexpr", cubeVertices), cubeVertices, []() {
+            MeshData mesh = ToMeshData(UnitCube);
+            Consume(mesh.indices.size());
+        });
+        runner.Run(Name("geometry/cube_runtime", cubeVertices), cubeVertices, []() {
+            MeshData mesh = CreateSubdividedCube({ 1.0f, 1 });
+            Consume(mesh.indices.size());
+        });
+    }
+
+    // Stands in for GeometryPool: places meshes with the same RangeAllocator
+    // and copies their data into CPU-side "GPU" storage.
+    class BenchGeometryDevice : public IGeometryDevice {
+    public:
+        BenchGeometryDevice(uint32_t maxVertices, uint32_t maxIndices)
+            : m_vertexAllocator(maxVertices), m_indexAllocator(maxIndices),
+            m_vertices(maxVertices), m_indices(maxIndices) {}
+
+        bool Upload(const MeshView& mesh, GpuMeshRange& range) override {
+            if (!m_vertexAllocator.Allocate(mesh.vertexCount, range.vertexOffset)) {
+                return false;
+            }
+            if (!m_indexAllocator.Allocate(mesh.indexCount, range.indexOffset)) {
+                m_vertexAllocator.Free(range.vertexOffset, mesh.vertexCount);
+                return false;
+            }
+            range.vertexCount = mesh.vertexCount;
+            range.indexCount = mesh.indexCount;
+            std::memcpy(&m_vertices[range.vertexOffset], mesh.vertices, mesh.vertexCount * sizeof(Vertex));
+            std::memcpy(&m_indices[range.indexOffset], mesh.indices, mesh.indexCount * sizeof(uint32_t));
+            return true;
+        }
+
+        void Evict(const GpuMeshRange& range) override {
+            m_vertexAllocator.Free(range.vertexOffset, range.vertexCount);
+            m_indexAllocator.Free(range.indexOffset, range.indexCount);
+        }
+
+    private:
+        RangeAllocator m_vertexAllocator;
+        RangeAllocator m_indexAllocator;
+        std::vector<Vertex> m_vertices;
+        std::vector<uint32_t> m_indices;
+    };
+
+    void BenchResidency(BenchmarkRunner& runner) {
+        constexpr uint32_t MeshCount = 1024;
+        constexpr uint32_t RequestsPerFrame = 256;
+
+        MeshData sphere = CreateSphere({ 0.5f, 16, 8, { 1.0f, 1.0f, 1.0f, 1.0f } });
+        uint64_t meshBytes = sphere.GetSizeInBytes();
+        BenchGeometryDevice device(MeshCount * static_cast<uint32_t>(sphere.vertices.size()),
+            MeshCount * static_cast<uint32_t>(sphere.indices.size()));
+
+        // Half the meshes fit, so random requests keep evicting and restoring.
+        ResidencyManager residency(device, meshBytes * MeshCount / 2);
+        std::vector<MeshHandle> handles;
+        for (uint32_t i = 0; i < MeshCount; ++i) {
+            handles.push_back(residency.RegisterStatic(sphere.GetView()));
+        }
+
+        std::mt19937 random(Seed);
+        std::uniform_int_distribution<uint32_t> pick(0, MeshCount - 1);
+        uint64_t frame = 0;
+        uint32_t failed = 0;
+        bool ran = runner.Run(Name("residency/churn", RequestsPerFrame), RequestsPerFrame, [&]() {
+            residency.BeginFrame(++frame);
+            for (uint32_t i = 0; i < RequestsPerFrame; ++i) {
+                GpuMeshRange range;
+                if (!residency.Request(handles[pick(random)], range)) {
+                    ++failed;
+                }
+            }
+        });
+        Check(failed == 0, "every residency request satisfied");
+        Check(residency.GetResidentBytes() <= residency.GetBudget(), "residency stays within budget");
+        if (ran) {
+            Check(residency.GetEvictionCount() > 0, "residency scenario evicts");
+        }
+    }
+
+    void BenchReplay(BenchmarkRunner& runner) {
+        std::filesystem::path path = std::filesystem::temp_directory_path() / "engine_bench_replay.gcap";
+
+        CaptureWriter writer;
+        if (!writer.Open(path.string())) {
+            Check(false, "open replay capture");
+            return;
+        }
+
+        Scene scene = BuildScene(SubmitMeshes);
+        writer.BeginFrame(1);
+        BufferDesc vertexDesc = { VertexBufferId, BufferUsage::Vertex, sizeof(UnitCube.vertices),
+            0x10000000, sizeof(Vertex), 0 };
+        BufferDesc indexDesc = { IndexBufferId, BufferUsage::Index, sizeof(UnitCube.indices),
+            0x20000000, sizeof(uint32_t), IndexFormatR32Uint };
+        BufferDesc argumentDesc = { ArgumentBufferId, BufferUsage::IndirectArguments,
+            sizeof(IndirectDrawCommand) * SubmitMeshes, 0x30000000, sizeof(IndirectDrawCommand), 0 };
+        BufferDesc countDesc = { CountBufferId, BufferUsage::IndirectCount, sizeof(uint32_t), 0x40000000, 0, 0 };
+        writer.CreateBuffer(vertexDesc);
+        writer.CreateBuffer(indexDesc);
+        writer.CreateBuffer(argumentDesc);
+        writer.CreateBuffer(countDesc);
+        writer.UploadBuffer(VertexBufferId, 0, UnitCube.vertices.data(), sizeof(UnitCube.vertices));
+        writer.UploadBuffer(IndexBufferId, 0, UnitCube.indices.data(), sizeof(UnitCube.indices));
+        writer.SetViewport({ 0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f });
+        writer.SetPipeline(1);
+        writer.Clear({ { 0.2f, 0.2f, 0.3f, 1.0f }, 1.0f });
+        uint32_t count = SubmitMeshes;
+        writer.UploadBuffer(ArgumentBufferId, 0, scene.commands.data(),
+            count * static_cast<uint32_t>(sizeof(IndirectDrawCommand)));
+        writer.UploadBuffer(CountBufferId, 0, &count, sizeof(count));
+        writer.ExecuteIndirect(ArgumentBufferId, CountBufferId, count);
+        writer.EndFrame();
+        writer.Close();
+
+        CaptureReader reader;
+        std::vector<uint8_t> frame;
+        bool loaded = reader.Open(path.string()) && reader.ReadFrame(frame);
+        std::error_code error;
+        std::filesystem::remove(path, error);
+        if (!loaded) {
+            Check(false, "read replay capture");
+            return;
+        }
+
+        NullBackend backend;
+        bool replayed = true;
+        bool ran = runner.Run(Name("replay/null_backend", SubmitMeshes), SubmitMeshes, [&]() {
+            replayed = ReplayFrame(frame.data(), frame.size(), backend, nullptr) && replayed;
+        }, NoisyTolerance);
+        if (ran) {
+            Check(replayed, "capture replays");
+            Check(backend.GetCounters().invalidCommands == 0, "replayed draws validate");
+            Check(backend.GetCounters().drawCalls > 0, "replayed draws executed");
+        }
+    }
+
+    void BenchInputAndScheduling(BenchmarkRunner& runner) {
+        InputManager input;
+        uint32_t frame = 0;
+        runner.Run(Name("input/update_query", InputManager::KeyCount), InputManager::KeyCount, [&]() {
+            ++frame;
+            for (int key = 0; key < 8; ++key) {
+                input.SetKeyState(key * 31, ((frame + key) & 1) != 0);
+            }
+            input.Update();
+            uint32_t pressed = 0;
+            for (int key = 0; key < InputManager::KeyCount; ++key) {
+                pressed += input.IsKeyPressed(key) ? 1 : 0;
+            }
+            Consume(pressed);
+        });
+
+        // Waking the persistent workers and joining them again is the fixed
+        // cost any parallel scenario above pays per ParallelFor call. With
+        // fewer cores than workers the caller can finish every chunk before a
+        // worker wakes, which only ever makes a sample faster.
+        for (uint32_t threads : ThreadCounts) {
+            SetWorkerCount(threads);
+            runner.Run(Name("scheduling/parallel_for", 1, threads), 1, []() {
+                std::atomic<uint32_t> sum{ 0 };
+                ParallelFor(4096, 256, [&sum](uint32_t begin, uint32_t end) {
+                    sum.fetch_add(end - begin, std::memory_order_relaxed);
+                });
+                Consume(sum.load());
+            });
+        }
+        SetWorkerCount(0);
+    }
+
+    void PrintUsage() {
+        std::cerr << "Usage: engine_bench [--quick] [--filter <text>] [--output <results.json>]\n"
+            << "                    [--baseline <baseline.json>] [--write-baseline <baseline.json>]\n"
+            << "                    [--tolerance <fraction>]\n";
+    }
+}
+
+int main(int argc, char** argv) {
+    uint32_t samples = 11;
+    double tolerance = 0.5;
+    std::string filter;
+    std::string outputPath = "engine_bench_results.json";
+    std::string baselinePath;
+    std::string writeBaselinePath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (argument == "--quick") {
+            samples = 3;
+        } else if (argument == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (argument == "--output" && hasValue) {
+            outputPath = argv[++i];
+        } else if (argument == "--baseline" && hasValue) {
+            baselinePath = argv[++i];
+        } else if (argument == "--write-baseline" && hasValue) {
+            writeBaselinePath = argv[++i];
+        } else if (argument == "--tolerance" && hasValue) {
+            tolerance = std::atof(argv[++i]);
+        } else {
+            PrintUsage();
+            return -1;
+        }
+    }
+
+    BenchmarkRunner runner(samples, filter);
+    BenchTransforms(runner);
+    BenchCulling(runner);
+    BenchSubmission(runner);
+    BenchAllocators(runner);
+    BenchGeometry(runner);
+    BenchResidency(runner);
+    BenchReplay(runner);
+    BenchInputAndScheduling(runner);
+
+    if (!WriteResultsJson(outputPath, runner.GetResults(), tolerance)) {
+        return -1;
+    }
+    std::cout << "Results written to " << outputPath << "\n";
+
+    if (!writeBaselinePath.empty()) {
+        if (!WriteResultsJson(writeBaselinePath, runner.GetResults(), tolerance)) {
+            return -1;
+        }
+        std::cout << "Baseline written to " << writeBaselinePath << "\n";
+    }
+
+    if (!g_valid) {
+        std::cerr << "One or more scenarios produced incorrect results\n";
+        return 1;
+    }
+
+    if (!baselinePath.empty()) {
+        std::vector<BenchmarkResult> baseline;
+        double baselineTolerance = tolerance;
+        if (!LoadResultsJson(baselinePath, baseline, baselineTolerance)) {
+            return -1;
+        }
+        if (!CompareWithBaseline(runner.GetResults(), baseline, baselineTolerance, filter)) {
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstdint>
+#include "IndirectDraw.h"
+
+enum class CommandType : uint8_t {
+    BeginFrame,
+    EndFrame,
+    CreateBuffer,
+    UploadBuffer,
+    SetViewport,
+    SetPipeline,
+    Clear,
+    DrawIndexed,
+    ExecuteIndirect,
+    Count
+};
+
+enum class BufferUsage : uint32_t {
+    Vertex,
+    Index,
+    IndirectArguments,
+    IndirectCount
+};
+
+struct BufferDesc {
+    uint32_t bufferId;
+    BufferUsage usage;
+    uint64_t sizeInBytes;
+    // GPU virtual address at capture time. Kept for inspecting captures;
+    // argument records no longer reference buffers by address.
+    uint64_t gpuAddress;
+    uint32_t stride;
+    // DXGI format value for index buffers, zero otherwise.
+    uint32_t format;
+};
+
+struct ViewportDesc {
+    float x, y, width, height;
+    float minDepth, maxDepth;
+};
+
+struct ClearDesc {
+    float color[4];
+    float depth;
+};
+
+// The device-facing commands the renderer issues each frame, expressed
+// without any D3D12 types. CaptureWriter records them, and any backend
+// (NullBackend on Linux, a D3D12 backend on Windows) can re-execute them.
+class ICommandBackend {
+public:
+    virtual ~ICommandBackend() = default;
+
+    virtual void BeginFrame(uint64_t frameIndex) = 0;
+    virtual void EndFrame() = 0;
+    virtual void CreateBuffer(const BufferDesc& desc) = 0;
+    virtual void UploadBuffer(uint32_t bufferId, uint64_t offset, const void* data, uint32_t size) = 0;
+    virtual void SetViewport(const ViewportDesc& viewport) = 0;
+    virtual void SetPipeline(uint32_t pipelineId) = 0;
+    virtual void Clear(const ClearDesc& clear) = 0;
+    virtual void DrawIndexed(const DrawIndexedArguments& arguments) = 0;
+    virtual void ExecuteIndirect(uint32_t argumentBufferId, uint32_t countBufferId, uint32_t maxCommands) = 0;
+};
@@ -0,0 +1,114 @@
+#include "Compression.h"
+#include <cstring>
+
+namespace {
+    constexpr size_t MinMatch = 4;
+    constexpr size_t MaxOffset = 65535;
+    constexpr uint32_t HashBits = 14;
+
+    uint32_t Hash(const uint8_t* data) {
+        uint32_t value;
+        std::memcpy(&value, data, sizeof(value));
+        return (value * 2654435761u) >> (32 - HashBits);
+    }
+
+    void WriteVarint(std::vector<uint8_t>& output, size_t value) {
+        while (value >= 0x80) {
+            output.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        output.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool ReadVarint(const uint8_t*& cursor, const uint8_t* end, size_t& value) {
+        value = 0;
+        for (int shift = 0; cursor < end && shift < 64; shift += 7) {
+            uint8_t byte = *cursor++;
+            value |= size_t(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+void CompressBlock(const uint8_t* data, size_t size, std::vector<uint8_t>& output) {
+    output.clear();
+    output.reserve(size / 2 + 16);
+
+    std::vector<size_t> table(size_t(1) << HashBits, SIZE_MAX);
+    size_t literalStart = 0;
+    size_t position = 0;
+
+    while (position + MinMatch <= size) {
+        uint32_t hash = Hash(data + position);
+        size_t candidate = table[hash];
+        table[hash] = position;
+
+        if (candidate == SIZE_MAX || position - candidate > MaxOffset ||
+            std::memcmp(data + candidate, data + position, MinMatch) != 0) {
+            ++position;
+            continue;
+        }
+
+        size_t length = MinMatch;
+        while (position + length < size && data[candidate + length] == data[position + length]) {
+            ++length;
+        }
+
+        WriteVarint(output, position - literalStart);
+        output.insert(output.end(), data + literalStart, data + position);
+        WriteVarint(output, length - MinMatch);
+        size_t offset = position - candidate;
+        output.push_back(static_cast<uint8_t>(offset & 0xff));
+        output.push_back(static_cast<uint8_t>(offset >> 8));
+
+        position += length;
+        literalStart = position;
+    }
+
+    WriteVarint(output, size - literalStart);
+    output.insert(output.end(), data + literalStart, data + size);
+}
+
+bool DecompressBlock(const uint8_t* data, size_t size, std::vector<uint8_t>& output, size_t expectedSize) {
+    output.clear();
+    output.reserve(expectedSize);
+
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+    while (cursor < end) {
+        size_t literals;
+        if (!ReadVarint(cursor, end, literals) || size_t(end - cursor) < literals ||
+            literals > expectedSize - output.size()) {
+            return false;
+        }
+        output.insert(output.end(), cursor, cursor + literals);
+        cursor += literals;
+
+        if (cursor == end) {
+            break;
+        }
+
+        size_t length;
+        if (!ReadVarint(cursor, end, length) || end - cursor < 2) {
+            return false;
+        }
+        size_t offset = size_t(cursor[0]) | (size_t(cursor[1]) << 8);
+        cursor += 2;
+        size_t remaining = expectedSize - output.size();
+        if (remaining < MinMatch || length > remaining - MinMatch || offset == 0 || offset > output.size()) {
+            return false;
+        }
+        length += MinMatch;
+
+        // Matches may overlap their own output, so copy byte by byte.
+        size_t from = output.size() - offset;
+        for (size_t i = 0; i < length; ++i) {
+            output.push_back(output[from + i]);
+        }
+    }
+
+    return output.size() == expectedSize;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Small byte-oriented LZ77 codec for capture streams. Each sequence is a
+// varint literal length, the literals, then (unless the input ends there) a
+// varint match length minus MinMatch and a 16-bit little-endian offset.
+void CompressBlock(const uint8_t* data, size_t size, std::vector<uint8_t>& output);
+// Fails on malformed input, including any sequence that would write past
+// expectedSize, so corrupt data never grows output beyond that.
+bool DecompressBlock(const uint8_t* data, size_t size, std::vector<uint8_t>& output, size_t expectedSize);
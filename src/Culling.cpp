@@ -0,0 +1,100 @@
+#include "Culling.h"
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+
+namespace {
+    constexpr uint32_t CullGrainSize = 4096;
+
+    Plane MakePlane(float a, float b, float c, float d) {
+        float length = std::sqrt(a * a + b * b + c * c);
+        if (length == 0.0f) {
+            return { { 0.0f, 0.0f, 0.0f }, d };
+        }
+        return { { a / length, b / length, c / length }, d / length };
+    }
+}
+
+Frustum ExtractFrustum(const Float4x4& viewProjection) {
+    // Clip coordinates are v * M, so each clip component is the dot product
+    // of v with one column of M.
+    const auto& m = viewProjection.m;
+    auto combine = [&m](int column, float sign) {
+        return MakePlane(
+            m[0][3] + sign * m[0][column],
+            m[1][3] + sign * m[1][column],
+            m[2][3] + sign * m[2][column],
+            m[3][3] + sign * m[3][column]);
+    };
+
+    Frustum frustum;
+    frustum.planes[0] = combine(0, 1.0f);   // left:   x >= -w
+    frustum.planes[1] = combine(0, -1.0f);  // right:  x <= w
+    frustum.planes[2] = combine(1, 1.0f);   // bottom: y >= -w
+    frustum.planes[3] = combine(1, -1.0f);  // top:    y <= w
+    frustum.planes[4] = MakePlane(m[0][2], m[1][2], m[2][2], m[3][2]); // near: z >= 0
+    frustum.planes[5] = combine(2, -1.0f);  // far:    z <= w
+    return frustum;
+}
+
+bool IsSphereVisible(const Frustum& frustum, const BoundingSphere& sphere) {
+    for (const Plane& plane : frustum.planes) {
+        float distance = plane.normal.x * sphere.center.x + plane.normal.y * sphere.center.y +
+            plane.normal.z * sphere.center.z + plane.distance;
+        if (distance < -sphere.radius) {
+            return false;
+        }
+    }
+    return true;
+}
+
+BoundingSphere ComputeBoundingSphere(const MeshView& mesh) {
+    if (mesh.vertexCount == 0) {
+        return { { 0.0f, 0.0f, 0.0f }, 0.0f };
+    }
+
+    Float3 minimum = mesh.vertices[0].position;
+    Float3 maximum = minimum;
+    for (uint32_t i = 1; i < mesh.vertexCount; ++i) {
+        const Float3& p = mesh.vertices[i].position;
+        minimum = { std::min(minimum.x, p.x), std::min(minimum.y, p.y), std::min(minimum.z, p.z) };
+        maximum = { std::max(maximum.x, p.x), std::max(maximum.y, p.y), std::max(maximum.z, p.z) };
+    }
+
+    Float3 center = { (minimum.x + maximum.x) * 0.5f, (minimum.y + maximum.y) * 0.5f,
+        (minimum.z + maximum.z) * 0.5f };
+    float radiusSquared = 0.0f;
+    for (uint32_t i = 0; i < mesh.vertexCount; ++i) {
+        const Float3& p = mesh.vertices[i].position;
+        float dx = p.x - center.x;
+        float dy = p.y - center.y;
+        float dz = p.z - center.z;
+        radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+    }
+    return { center, std::sqrt(radiusSquared) };
+}
+
+BoundingSphere TransformSphere(const BoundingSphere& sphere, const Float4x4& world) {
+    const auto& m = world.m;
+    float scaleSquared = 0.0f;
+    for (int row = 0; row < 3; ++row) {
+        scaleSquared = std::max(scaleSquared,
+            m[row][0] * m[row][0] + m[row][1] * m[row][1] + m[row][2] * m[row][2]);
+    }
+    return { TransformPoint(sphere.center, world), sphere.radius * std::sqrt(scaleSquared) };
+}
+
+uint32_t CullSpheres(const Frustum& frustum, const BoundingSphere* spheres, uint32_t count,
+    uint8_t* visibility) {
+    std::atomic<uint32_t> visibleCount{ 0 };
+    ParallelFor(count, CullGrainSize, [&](uint32_t begin, uint32_t end) {
+        uint32_t visible = 0;
+        for (uint32_t i = begin; i < end; ++i) {
+            visibility[i] = IsSphereVisible(frustum, spheres[i]) ? 1 : 0;
+            visible += visibility[i];
+        }
+        visibleCount.fetch_add(visible, std::memory_order_relaxed);
+    });
+    return visibleCount.load(std::memory_order_relaxed);
+}
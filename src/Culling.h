@@ -0,0 +1,37 @@
+#pragma once
+#include <cstdint>
+#include "Geometry.h"
+#include "Transform.h"
+
+// Points with dot(normal, p) + distance >= 0 are on the inner side.
+struct Plane {
+    Float3 normal;
+    float distance;
+};
+
+struct Frustum {
+    Plane planes[6];
+};
+
+struct BoundingSphere {
+    Float3 center;
+    float radius;
+};
+
+// Extracts the six normalized planes from a row-vector view-projection
+// matrix with D3D clip-space depth (0 <= z <= w).
+Frustum ExtractFrustum(const Float4x4& viewProjection);
+
+bool IsSphereVisible(const Frustum& frustum, const BoundingSphere& sphere);
+
+// Sphere around the mesh's axis-aligned bounds: not minimal, but cheap and
+// stable across hot reloads that only move a few vertices.
+BoundingSphere ComputeBoundingSphere(const MeshView& mesh);
+
+// Conservative: the radius is scaled by the largest axis scale in world.
+BoundingSphere TransformSphere(const BoundingSphere& sphere, const Float4x4& world);
+
+// Writes 1 for every sphere that intersects the frustum and 0 otherwise, in
+// the layout CompactDrawCommands consumes, and returns the visible count.
+uint32_t CullSpheres(const Frustum& frustum, const BoundingSphere* spheres, uint32_t count,
+    uint8_t* visibility);
@@ -0,0 +1,95 @@
+#include "DependencyTracker.h"
+#include <algorithm>
+#include <filesystem>
+#include <functional>
+
+std::string NormalizePath(const std::string& path) {
+    std::string normalized = std::filesystem::path(path).lexically_normal().generic_string();
+    if (normalized.size() > 1 && normalized.back() == '/') {
+        normalized.pop_back();
+    }
+    return normalized;
+}
+
+void DependencyTracker::SetDependencies(const std::string& target, const std::vector<std::string>& inputs) {
+    RemoveTarget(target);
+
+    std::set<std::string>& dependencies = m_dependencies[target];
+    for (const auto& input : inputs) {
+        dependencies.insert(input);
+        m_dependents[input].insert(target);
+    }
+}
+
+void DependencyTracker::RemoveTarget(const std::string& target) {
+    auto it = m_dependencies.find(target);
+    if (it == m_dependencies.end()) {
+        return;
+    }
+
+    for (const auto& input : it->second) {
+        auto dependents = m_dependents.find(input);
+        if (dependents != m_dependents.end()) {
+            dependents->second.erase(target);
+            if (dependents->second.empty()) {
+                m_dependents.erase(dependents);
+            }
+        }
+    }
+    m_dependencies.erase(it);
+}
+
+bool DependencyTracker::HasTarget(const std::string& target) const {
+    return m_dependencies.count(target) != 0;
+}
+
+std::vector<std::string> DependencyTracker::GetDependencies(const std::string& target) const {
+    auto it = m_dependencies.find(target);
+    if (it == m_dependencies.end()) {
+        return {};
+    }
+    return std::vector<std::string>(it->second.begin(), it->second.end());
+}
+
+std::vector<std::string> DependencyTracker::GetAffectedTargets(const std::vector<std::string>& changedInputs) const {
+    std::set<std::string> affected;
+    std::vector<std::string> pending(changedInputs.begin(), changedInputs.end());
+
+    while (!pending.empty()) {
+        std::string input = std::move(pending.back());
+        pending.pop_back();
+
+        auto dependents = m_dependents.find(input);
+        if (dependents == m_dependents.end()) {
+            continue;
+        }
+        for (const auto& target : dependents->second) {
+            if (affected.insert(target).second) {
+                pending.push_back(target);
+            }
+        }
+    }
+
+    // Depth-first post-order over the affected subgraph puts dependencies first.
+    std::vector<std::string> ordered;
+    std::set<std::string> visited;
+    std::function<void(const std::string&)> visit = [&](const std::string& target) {
+        if (!visited.insert(target).second) {
+            return;
+        }
+        auto dependencies = m_dependencies.find(target);
+        if (dependencies != m_dependencies.end()) {
+            for (const auto& input : dependencies->second) {
+                if (affected.count(input)) {
+                    visit(input);
+                }
+            }
+        }
+        ordered.push_back(target);
+    };
+
+    for (const auto& target : affected) {
+        visit(target);
+    }
+    return ordered;
+}
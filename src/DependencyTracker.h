@@ -0,0 +1,30 @@
+#pragma once
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+// Converts a path to the form used as a key by DependencyTracker and
+// FileWatcher: forward slashes, with "." and ".." segments resolved.
+std::string NormalizePath(const std::string& path);
+
+// Directed graph from build targets (shader permutations, pipelines, meshes)
+// to the inputs they were built from. Inputs may be files or other targets,
+// so a header change reaches every shader that includes it and, through
+// them, every pipeline that uses those shaders.
+class DependencyTracker {
+public:
+    void SetDependencies(const std::string& target, const std::vector<std::string>& inputs);
+    void RemoveTarget(const std::string& target);
+
+    bool HasTarget(const std::string& target) const;
+    std::vector<std::string> GetDependencies(const std::string& target) const;
+
+    // Every target that transitively depends on any of the changed inputs,
+    // ordered so that a target comes after all the targets it depends on.
+    std::vector<std::string> GetAffectedTargets(const std::vector<std::string>& changedInputs) const;
+
+private:
+    std::map<std::string, std::set<std::string>> m_dependencies;
+    std::map<std::string, std::set<std::string>> m_dependents;
+};
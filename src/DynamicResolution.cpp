@@ -0,0 +1,63 @@
+#include "DynamicResolution.h"
+#include <algorithm>
+#include <cmath>
+
+DynamicResolutionController::DynamicResolutionController(const DynamicResolutionSettings& settings)
+    : m_settings(settings), m_scale(settings.maxScale), m_smoothedCostMs(0.0f), m_hasSample(false) {}
+
+void DynamicResolutionController::Reset() {
+    m_scale = m_settings.maxScale;
+    m_smoothedCostMs = 0.0f;
+    m_hasSample = false;
+}
+
+void DynamicResolutionController::SetSettings(const DynamicResolutionSettings& settings) {
+    m_settings = settings;
+    m_scale = Clamp(m_scale);
+}
+
+float DynamicResolutionController::Clamp(float scale) const {
+    return std::min(m_settings.maxScale, std::max(m_settings.minScale, scale));
+}
+
+float DynamicResolutionController::Update(float gpuFrameTimeMs) {
+    if (!(gpuFrameTimeMs > 0.0f)) {
+        return m_scale;
+    }
+
+    float budget = m_settings.targetFrameTimeMs * m_settings.headroom;
+    bool panic = gpuFrameTimeMs > m_settings.targetFrameTimeMs * m_settings.panicRatio;
+
+    // Smooth the cost at full resolution rather than the raw time: samples
+    // taken at different scales are only comparable once normalized, and a
+    // spike would otherwise keep pushing the scale down after it has been
+    // corrected for.
+    float cost = gpuFrameTimeMs / (m_scale * m_scale);
+    if (!m_hasSample || panic) {
+        m_smoothedCostMs = cost;
+        m_hasSample = true;
+    } else {
+        m_smoothedCostMs += m_settings.smoothing * (cost - m_smoothedCostMs);
+    }
+
+    float ideal = Clamp(std::sqrt(budget / m_smoothedCostMs));
+    float delta = ideal - m_scale;
+
+    // The deadband only filters noise around an interior ideal; a clamped
+    // ideal is always reached so the scale can settle on its bounds.
+    bool atBound = ideal <= m_settings.minScale || ideal >= m_settings.maxScale;
+    if (std::fabs(delta) < m_settings.deadband && !panic && !atBound) {
+        return m_scale;
+    }
+
+    if (panic) {
+        m_scale = ideal;
+    } else if (delta > 0.0f) {
+        m_scale += std::min(delta, m_settings.maxStepUp);
+    } else {
+        m_scale += std::max(delta, -m_settings.maxStepDown);
+    }
+
+    m_scale = Clamp(m_scale);
+    return m_scale;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstdint>
+
+struct DynamicResolutionSettings {
+    float targetFrameTimeMs = 1000.0f / 60.0f;
+    // Fraction of the target the controller aims for, leaving room for noise.
+    float headroom = 0.9f;
+    float minScale = 0.5f;
+    float maxScale = 1.0f;
+    // Weight of the newest sample in the exponential moving average.
+    float smoothing = 0.2f;
+    // Largest scale change per frame when there is spare GPU time; drops are
+    // allowed to be larger so overload is corrected quickly.
+    float maxStepUp = 0.02f;
+    float maxStepDown = 0.1f;
+    // Changes smaller than this are ignored to avoid resizing on noise.
+    float deadband = 0.02f;
+    // A single frame this far over target skips smoothing and drops at once.
+    float panicRatio = 1.25f;
+};
+
+// Chooses the per-axis render scale from measured GPU frame times. GPU cost
+// is modelled as proportional to pixel count (scale squared): the smoothed
+// cost at full resolution predicts the scale that would meet the target, and
+// the controller moves towards it with rate limits and a deadband.
+class DynamicResolutionController {
+public:
+    explicit DynamicResolutionController(const DynamicResolutionSettings& settings = DynamicResolutionSettings());
+
+    float Update(float gpuFrameTimeMs);
+    void Reset();
+
+    void SetSettings(const DynamicResolutionSettings& settings);
+    const DynamicResolutionSettings& GetSettings() const { return m_settings; }
+
+    float GetScale() const { return m_scale; }
+    // Smoothed GPU time predicted at the current scale.
+    float GetSmoothedFrameTime() const { return m_smoothedCostMs * m_scale * m_scale; }
+
+private:
+    float Clamp(float scale) const;
+
+    DynamicResolutionSettings m_settings;
+    float m_scale;
+    // Smoothed GPU cost of a frame at full resolution.
+    float m_smoothedCostMs;
+    bool m_hasSample;
+};
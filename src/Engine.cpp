@@ -1,7 +1,7 @@
 #include "Engine.h"
 #include <iostream>
 
-Engine::Engine() : m_isRunning(false) {}
+Engine::Engine() : m_isRunning(false), m_allocationMonitor(AllocationWarmupFrames) {}
 
 Engine::~Engine() {
     Shutdown();
@@ -36,13 +36,38 @@ bool Engine::Initialize(int width, int height, const char* title){
 
 void Engine::Run(){
     while(m_isRunning) {
+        MemoryTracker::BeginFrame();
         m_isRunning = HandleMessages();
 
         m_inputManager->Update();
 
+        if (m_inputManager->IsKeyPressed(VK_F12) && !m_renderer->IsCapturing()) {
+            m_renderer->StartCapture("frame_capture.gcap", 1);
+        }
+
+        int width = 0;
+        int height = 0;
+        if (m_window->ConsumeResize(width, height) && !m_renderer->Resize(width, height)) {
+            std::cerr << "Failed to resize renderer\n";
+            m_isRunning = false;
+            break;
+        }
+
         m_renderer->BeginFrame();
         m_renderer->Render();
         m_renderer->EndFrame();
+
+        uint64_t allocations = m_allocationMonitor.EndFrame();
+        if (allocations != 0 && m_allocationMonitor.GetAllocatingFrames() == 1) {
+            std::cerr << "Frame " << m_allocationMonitor.GetFrames() << " allocated " << allocations
+                << " time(s) after warm-up\n";
+        }
+    }
+
+    if (m_allocationMonitor.GetAllocatingFrames() != 0) {
+        std::cerr << m_allocationMonitor.GetAllocatingFrames() << " of "
+            << m_allocationMonitor.GetFrames() << " frames allocated after warm-up ("
+            << m_allocationMonitor.GetSteadyStateAllocations() << " allocations)\n";
     }
 }
 
@@ -3,6 +3,7 @@
 #include "Window.h"
 #include "Renderer.h"
 #include "InputManager.h"
+#include "Memory.h"
 
 class Engine {
 public:
@@ -20,4 +21,8 @@ private:
     std::unique_ptr<Renderer> m_renderer;
     std::unique_ptr<InputManager> m_inputManager;
     bool m_isRunning;
+
+    // Frames allowed to allocate while caches, pools and pipelines settle.
+    static constexpr uint64_t AllocationWarmupFrames = 120;
+    FrameAllocationMonitor m_allocationMonitor;
 };
\ No newline at end of file
@@ -0,0 +1,259 @@
+#include "FileWatcher.h"
+#include "DependencyTracker.h"
+#include <algorithm>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <memory>
+
+namespace {
+    struct WatchedDirectory {
+        std::string path;
+        HANDLE handle = INVALID_HANDLE_VALUE;
+        OVERLAPPED overlapped = {};
+        alignas(DWORD) unsigned char buffer[16 * 1024];
+    };
+
+    bool IssueRead(WatchedDirectory& directory) {
+        return ReadDirectoryChangesW(directory.handle, directory.buffer, sizeof(directory.buffer), FALSE,
+            FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_SIZE,
+            nullptr, &directory.overlapped, nullptr) != FALSE;
+    }
+
+    std::string ToUtf8(const wchar_t* text, int length) {
+        int size = WideCharToMultiByte(CP_UTF8, 0, text, length, nullptr, 0, nullptr, nullptr);
+        std::string result(size, '\0');
+        WideCharToMultiByte(CP_UTF8, 0, text, length, &result[0], size, nullptr, nullptr);
+        return result;
+    }
+
+    std::wstring ToWide(const std::string& text) {
+        int length = static_cast<int>(text.size());
+        int size = MultiByteToWideChar(CP_UTF8, 0, text.data(), length, nullptr, 0);
+        std::wstring result(size, L'\0');
+        MultiByteToWideChar(CP_UTF8, 0, text.data(), length, &result[0], size);
+        return result;
+    }
+
+    enum class FileState {
+        Ready,
+        Busy,
+        Missing,
+    };
+
+    // Windows reports every write as it happens, not when the writer is
+    // done. Opening without FILE_SHARE_WRITE fails while anyone still has
+    // the file open for writing, so a half-written file is retried later.
+    FileState GetFileState(const std::string& path) {
+        HANDLE file = CreateFileW(ToWide(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file != INVALID_HANDLE_VALUE) {
+            CloseHandle(file);
+            return FileState::Ready;
+        }
+
+        DWORD error = GetLastError();
+        if (error == ERROR_FILE_NOT_FOUND || error == ERROR_PATH_NOT_FOUND) {
+            return FileState::Missing;
+        }
+        return FileState::Busy;
+    }
+
+    // Used when the notification buffer overflowed and the individual
+    // changes are lost.
+    void ListFiles(const std::string& directory, std::vector<std::string>& files) {
+        WIN32_FIND_DATAW data;
+        HANDLE find = FindFirstFileW(ToWide(directory + "/*").c_str(), &data);
+        if (find == INVALID_HANDLE_VALUE) {
+            return;
+        }
+        do {
+            if (!(data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)) {
+                std::string name = ToUtf8(data.cFileName, static_cast<int>(wcslen(data.cFileName)));
+                files.push_back(NormalizePath(directory + "/" + name));
+            }
+        } while (FindNextFileW(find, &data));
+        FindClose(find);
+    }
+}
+
+struct FileWatcher::Impl {
+    std::vector<std::unique_ptr<WatchedDirectory>> directories;
+    // Changed files that were still open for writing at the last Poll.
+    std::vector<std::string> pending;
+};
+
+FileWatcher::FileWatcher() : m_impl(std::make_unique<Impl>()) {}
+
+FileWatcher::~FileWatcher() {
+    Shutdown();
+}
+
+bool FileWatcher::Watch(const std::string& directory) {
+    HANDLE handle = CreateFileW(ToWide(directory).c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    auto watched = std::make_unique<WatchedDirectory>();
+    watched->path = NormalizePath(directory);
+    watched->handle = handle;
+    watched->overlapped.hEvent = CreateEventW(nullptr, TRUE, FALSE, nullptr);
+
+    if (!watched->overlapped.hEvent || !IssueRead(*watched)) {
+        if (watched->overlapped.hEvent) {
+            CloseHandle(watched->overlapped.hEvent);
+        }
+        CloseHandle(handle);
+        return false;
+    }
+
+    m_impl->directories.push_back(std::move(watched));
+    return true;
+}
+
+void FileWatcher::Poll(std::vector<std::string>& changedFiles) {
+    std::vector<std::string> candidates;
+    candidates.swap(m_impl->pending);
+
+    for (auto& directory : m_impl->directories) {
+        DWORD bytes = 0;
+        if (!GetOverlappedResult(directory->handle, &directory->overlapped, &bytes, FALSE)) {
+            continue;
+        }
+
+        // A completed read with no data means the buffer overflowed.
+        if (bytes == 0) {
+            ListFiles(directory->path, candidates);
+        }
+
+        const unsigned char* cursor = directory->buffer;
+        while (bytes > 0) {
+            const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(cursor);
+            if (info->Action != FILE_ACTION_REMOVED && info->Action != FILE_ACTION_RENAMED_OLD_NAME) {
+                std::string name = ToUtf8(info->FileName, static_cast<int>(info->FileNameLength / sizeof(wchar_t)));
+                candidates.push_back(NormalizePath(directory->path + "/" + name));
+            }
+            if (info->NextEntryOffset == 0) {
+                break;
+            }
+            cursor += info->NextEntryOffset;
+        }
+
+        ResetEvent(directory->overlapped.hEvent);
+        IssueRead(*directory);
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    for (auto& path : candidates) {
+        FileState state = GetFileState(path);
+        if (state == FileState::Ready) {
+            changedFiles.push_back(std::move(path));
+        } else if (state == FileState::Busy) {
+            m_impl->pending.push_back(std::move(path));
+        }
+    }
+
+    std::sort(changedFiles.begin(), changedFiles.end());
+    changedFiles.erase(std::unique(changedFiles.begin(), changedFiles.end()), changedFiles.end());
+}
+
+void FileWatcher::Shutdown() {
+    for (auto& directory : m_impl->directories) {
+        CancelIoEx(directory->handle, &directory->overlapped);
+        DWORD bytes = 0;
+        GetOverlappedResult(directory->handle, &directory->overlapped, &bytes, TRUE);
+        CloseHandle(directory->overlapped.hEvent);
+        CloseHandle(directory->handle);
+    }
+    m_impl->directories.clear();
+    m_impl->pending.clear();
+}
+
+#else
+#include <cerrno>
+#include <filesystem>
+#include <map>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+struct FileWatcher::Impl {
+    int fd = -1;
+    std::map<int, std::string> directories;
+};
+
+FileWatcher::FileWatcher() : m_impl(std::make_unique<Impl>()) {}
+
+FileWatcher::~FileWatcher() {
+    Shutdown();
+}
+
+bool FileWatcher::Watch(const std::string& directory) {
+    if (m_impl->fd < 0) {
+        m_impl->fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_impl->fd < 0) {
+            return false;
+        }
+    }
+
+    // Only finished writes and renames into place, so an editor that is
+    // still writing never produces a half-saved file.
+    int wd = inotify_add_watch(m_impl->fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (wd < 0) {
+        return false;
+    }
+
+    m_impl->directories[wd] = NormalizePath(directory);
+    return true;
+}
+
+void FileWatcher::Poll(std::vector<std::string>& changedFiles) {
+    if (m_impl->fd < 0) {
+        return;
+    }
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    for (;;) {
+        ssize_t length = read(m_impl->fd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break;
+        }
+
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(cursor);
+            // Events were dropped; report everything that might have changed.
+            if (event->mask & IN_Q_OVERFLOW) {
+                for (const auto& watched : m_impl->directories) {
+                    std::error_code error;
+                    std::filesystem::directory_iterator entry(watched.second, error);
+                    for (; !error && entry != std::filesystem::directory_iterator(); entry.increment(error)) {
+                        if (entry->is_regular_file(error)) {
+                            changedFiles.push_back(NormalizePath(entry->path().generic_string()));
+                        }
+                    }
+                }
+            }
+
+            auto directory = m_impl->directories.find(event->wd);
+            if (event->len > 0 && !(event->mask & IN_ISDIR) && directory != m_impl->directories.end()) {
+                changedFiles.push_back(NormalizePath(directory->second + "/" + event->name));
+            }
+            cursor += sizeof(inotify_event) + event->len;
+        }
+    }
+
+    std::sort(changedFiles.begin(), changedFiles.end());
+    changedFiles.erase(std::unique(changedFiles.begin(), changedFiles.end()), changedFiles.end());
+}
+
+void FileWatcher::Shutdown() {
+    if (m_impl->fd >= 0) {
+        close(m_impl->fd);
+        m_impl->fd = -1;
+    }
+    m_impl->directories.clear();
+}
+#endif
@@ -0,0 +1,29 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+// Non-blocking directory watcher. Poll reports every file under a watched
+// directory that was written or renamed into place since the last call. A
+// write is only reported once the writer is done with the file: on Linux
+// when it closes the file, on Windows once the file can be opened without
+// sharing write access (until then it is retried on later polls). If the
+// change queue overflows, every file in the directory is reported. Backed by
+// inotify on Linux and ReadDirectoryChangesW on Windows; directories are
+// watched non-recursively.
+class FileWatcher {
+public:
+    FileWatcher();
+    ~FileWatcher();
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool Watch(const std::string& directory);
+    void Poll(std::vector<std::string>& changedFiles);
+    void Shutdown();
+
+private:
+    struct Impl;
+    std::unique_ptr<Impl> m_impl;
+};
@@ -0,0 +1,285 @@
+#include "FrameCapture.h"
+#include "Compression.h"
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+    struct UploadHeader {
+        uint32_t bufferId;
+        uint32_t size;
+        uint64_t offset;
+    };
+
+    struct IndirectPayload {
+        uint32_t argumentBufferId;
+        uint32_t countBufferId;
+        uint32_t maxCommands;
+    };
+
+    struct EmptyPayload {};
+
+    const char* g_commandNames[static_cast<size_t>(CommandType::Count)] = {
+        "BeginFrame",
+        "EndFrame",
+        "CreateBuffer",
+        "UploadBuffer",
+        "SetViewport",
+        "SetPipeline",
+        "Clear",
+        "DrawIndexed",
+        "ExecuteIndirect",
+    };
+
+    template <typename T>
+    bool Read(const uint8_t*& cursor, const uint8_t* end, T& value) {
+        if (size_t(end - cursor) < sizeof(T)) {
+            return false;
+        }
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return true;
+    }
+}
+
+CaptureWriter::CaptureWriter()
+    : m_framesWritten(0), m_rawBytes(0), m_compressedBytes(0) {}
+
+CaptureWriter::~CaptureWriter() {
+    Close();
+}
+
+bool CaptureWriter::Open(const std::string& path) {
+    Close();
+
+    m_file.open(path, std::ios::binary | std::ios::trunc);
+    if (!m_file) {
+        return false;
+    }
+
+    m_file.write(reinterpret_cast<const char*>(&CaptureMagic), sizeof(CaptureMagic));
+    m_file.write(reinterpret_cast<const char*>(&CaptureVersion), sizeof(CaptureVersion));
+    m_frame.clear();
+    m_framesWritten = 0;
+    m_rawBytes = 0;
+    m_compressedBytes = 0;
+    return static_cast<bool>(m_file);
+}
+
+void CaptureWriter::Close() {
+    if (!m_file.is_open()) {
+        return;
+    }
+    Flush();
+    m_file.close();
+}
+
+template <typename T>
+void CaptureWriter::Write(CommandType type, const T& payload) {
+    m_frame.push_back(static_cast<uint8_t>(type));
+    if (!std::is_empty<T>::value) {
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&payload);
+        m_frame.insert(m_frame.end(), bytes, bytes + sizeof(T));
+    }
+}
+
+void CaptureWriter::Flush() {
+    if (m_frame.empty() || !m_file.is_open()) {
+        return;
+    }
+
+    CompressBlock(m_frame.data(), m_frame.size(), m_compressed);
+
+    uint32_t rawSize = static_cast<uint32_t>(m_frame.size());
+    uint32_t compressedSize = static_cast<uint32_t>(m_compressed.size());
+    m_file.write(reinterpret_cast<const char*>(&rawSize), sizeof(rawSize));
+    m_file.write(reinterpret_cast<const char*>(&compressedSize), sizeof(compressedSize));
+    m_file.write(reinterpret_cast<const char*>(m_compressed.data()), compressedSize);
+
+    m_rawBytes += rawSize;
+    m_compressedBytes += compressedSize;
+    ++m_framesWritten;
+    m_frame.clear();
+}
+
+void CaptureWriter::BeginFrame(uint64_t frameIndex) {
+    Write(CommandType::BeginFrame, frameIndex);
+}
+
+void CaptureWriter::EndFrame() {
+    Write(CommandType::EndFrame, EmptyPayload());
+    Flush();
+}
+
+void CaptureWriter::CreateBuffer(const BufferDesc& desc) {
+    Write(CommandType::CreateBuffer, desc);
+}
+
+void CaptureWriter::UploadBuffer(uint32_t bufferId, uint64_t offset, const void* data, uint32_t size) {
+    UploadHeader header = { bufferId, size, offset };
+    Write(CommandType::UploadBuffer, header);
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    m_frame.insert(m_frame.end(), bytes, bytes + size);
+}
+
+void CaptureWriter::SetViewport(const ViewportDesc& viewport) {
+    Write(CommandType::SetViewport, viewport);
+}
+
+void CaptureWriter::SetPipeline(uint32_t pipelineId) {
+    Write(CommandType::SetPipeline, pipelineId);
+}
+
+void CaptureWriter::Clear(const ClearDesc& clear) {
+    Write(CommandType::Clear, clear);
+}
+
+void CaptureWriter::DrawIndexed(const DrawIndexedArguments& arguments) {
+    Write(CommandType::DrawIndexed, arguments);
+}
+
+void CaptureWriter::ExecuteIndirect(uint32_t argumentBufferId, uint32_t countBufferId, uint32_t maxCommands) {
+    IndirectPayload payload = { argumentBufferId, countBufferId, maxCommands };
+    Write(CommandType::ExecuteIndirect, payload);
+}
+
+bool CaptureReader::Open(const std::string& path) {
+    m_file.open(path, std::ios::binary | std::ios::ate);
+    if (!m_file) {
+        return false;
+    }
+
+    uint64_t fileSize = static_cast<uint64_t>(m_file.tellg());
+    m_file.seekg(0);
+
+    uint32_t magic = 0;
+    uint32_t version = 0;
+    m_file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+    m_file.read(reinterpret_cast<char*>(&version), sizeof(version));
+    if (!m_file || magic != CaptureMagic || version != CaptureVersion) {
+        return false;
+    }
+
+    m_remainingBytes = fileSize - sizeof(magic) - sizeof(version);
+    return true;
+}
+
+bool CaptureReader::ReadFrame(std::vector<uint8_t>& frame) {
+    uint32_t rawSize = 0;
+    uint32_t compressedSize = 0;
+    if (m_remainingBytes < sizeof(rawSize) + sizeof(compressedSize) ||
+        !m_file.read(reinterpret_cast<char*>(&rawSize), sizeof(rawSize)) ||
+        !m_file.read(reinterpret_cast<char*>(&compressedSize), sizeof(compressedSize))) {
+        return false;
+    }
+    m_remainingBytes -= sizeof(rawSize) + sizeof(compressedSize);
+
+    // Sizes come from the file, so check them before allocating anything.
+    if (rawSize > MaxCaptureFrameSize || compressedSize > m_remainingBytes) {
+        m_remainingBytes = 0;
+        return false;
+    }
+    m_remainingBytes -= compressedSize;
+
+    m_compressed.resize(compressedSize);
+    if (!m_file.read(reinterpret_cast<char*>(m_compressed.data()), compressedSize)) {
+        return false;
+    }
+
+    return DecompressBlock(m_compressed.data(), m_compressed.size(), frame, rawSize);
+}
+
+void ReplayStats::Record(CommandType type, uint64_t nanoseconds) {
+    CommandTiming& timing = timings[static_cast<size_t>(type)];
+    if (timing.count == 0 || nanoseconds < timing.minNanoseconds) {
+        timing.minNanoseconds = nanoseconds;
+    }
+    if (nanoseconds > timing.maxNanoseconds) {
+        timing.maxNanoseconds = nanoseconds;
+    }
+    timing.totalNanoseconds += nanoseconds;
+    ++timing.count;
+}
+
+const char* GetCommandName(CommandType type) {
+    size_t index = static_cast<size_t>(type);
+    return index < static_cast<size_t>(CommandType::Count) ? g_commandNames[index] : "Unknown";
+}
+
+bool ReplayFrame(const uint8_t* data, size_t size, ICommandBackend& backend, ReplayStats* stats) {
+    using Clock = std::chrono::steady_clock;
+
+    const uint8_t* cursor = data;
+    const uint8_t* end = data + size;
+    while (cursor < end) {
+        CommandType type = static_cast<CommandType>(*cursor++);
+        Clock::time_point start = Clock::now();
+
+        switch (type) {
+        case CommandType::BeginFrame: {
+            uint64_t frameIndex;
+            if (!Read(cursor, end, frameIndex)) return false;
+            backend.BeginFrame(frameIndex);
+            break;
+        }
+        case CommandType::EndFrame:
+            backend.EndFrame();
+            if (stats) {
+                ++stats->frames;
+            }
+            break;
+        case CommandType::CreateBuffer: {
+            BufferDesc desc;
+            if (!Read(cursor, end, desc)) return false;
+            backend.CreateBuffer(desc);
+            break;
+        }
+        case CommandType::UploadBuffer: {
+            UploadHeader header;
+            if (!Read(cursor, end, header) || size_t(end - cursor) < header.size) return false;
+            backend.UploadBuffer(header.bufferId, header.offset, cursor, header.size);
+            cursor += header.size;
+            break;
+        }
+        case CommandType::SetViewport: {
+            ViewportDesc viewport;
+            if (!Read(cursor, end, viewport)) return false;
+            backend.SetViewport(viewport);
+            break;
+        }
+        case CommandType::SetPipeline: {
+            uint32_t pipelineId;
+            if (!Read(cursor, end, pipelineId)) return false;
+            backend.SetPipeline(pipelineId);
+            break;
+        }
+        case CommandType::Clear: {
+            ClearDesc clear;
+            if (!Read(cursor, end, clear)) return false;
+            backend.Clear(clear);
+            break;
+        }
+        case CommandType::DrawIndexed: {
+            DrawIndexedArguments arguments;
+            if (!Read(cursor, end, arguments)) return false;
+            backend.DrawIndexed(arguments);
+            break;
+        }
+        case CommandType::ExecuteIndirect: {
+            IndirectPayload payload;
+            if (!Read(cursor, end, payload)) return false;
+            backend.ExecuteIndirect(payload.argumentBufferId, payload.countBufferId, payload.maxCommands);
+            break;
+        }
+        default:
+            return false;
+        }
+
+        if (stats) {
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+            stats->Record(type, static_cast<uint64_t>(elapsed.count()));
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "CommandBackend.h"
+
+// Capture files start with a small header followed by one compressed chunk
+// per frame: uint32 raw size, uint32 compressed size, compressed bytes.
+constexpr uint32_t CaptureMagic = 0x50414347; // "GCAP"
+// Version 2: indirect argument records hold only the draw arguments.
+constexpr uint32_t CaptureVersion = 2;
+// Largest uncompressed frame CaptureReader accepts; a full geometry snapshot
+// of the renderer's pool is well below this.
+constexpr uint32_t MaxCaptureFrameSize = 256u * 1024 * 1024;
+
+// Records every command into a per-frame byte stream and streams it to disk,
+// compressed, when the frame ends.
+class CaptureWriter : public ICommandBackend {
+public:
+    CaptureWriter();
+    ~CaptureWriter();
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_file.is_open(); }
+
+    uint64_t GetFramesWritten() const { return m_framesWritten; }
+    uint64_t GetRawBytes() const { return m_rawBytes; }
+    uint64_t GetCompressedBytes() const { return m_compressedBytes; }
+
+    void BeginFrame(uint64_t frameIndex) override;
+    void EndFrame() override;
+    void CreateBuffer(const BufferDesc& desc) override;
+    void UploadBuffer(uint32_t bufferId, uint64_t offset, const void* data, uint32_t size) override;
+    void SetViewport(const ViewportDesc& viewport) override;
+    void SetPipeline(uint32_t pipelineId) override;
+    void Clear(const ClearDesc& clear) override;
+    void DrawIndexed(const DrawIndexedArguments& arguments) override;
+    void ExecuteIndirect(uint32_t argumentBufferId, uint32_t countBufferId, uint32_t maxCommands) override;
+
+private:
+    template <typename T>
+    void Write(CommandType type, const T& payload);
+    void Flush();
+
+    std::ofstream m_file;
+    std::vector<uint8_t> m_frame;
+    std::vector<uint8_t> m_compressed;
+    uint64_t m_framesWritten;
+    uint64_t m_rawBytes;
+    uint64_t m_compressedBytes;
+};
+
+// Reads frames back from a capture file. ReadFrame fails on the first frame
+// whose sizes do not fit the file or MaxCaptureFrameSize, or that does not
+// decompress to its recorded size.
+class CaptureReader {
+public:
+    bool Open(const std::string& path);
+    bool ReadFrame(std::vector<uint8_t>& frame);
+
+private:
+    std::ifstream m_file;
+    std::vector<uint8_t> m_compressed;
+    uint64_t m_remainingBytes = 0;
+};
+
+struct CommandTiming {
+    uint64_t count;
+    uint64_t totalNanoseconds;
+    uint64_t minNanoseconds;
+    uint64_t maxNanoseconds;
+};
+
+struct ReplayStats {
+    CommandTiming timings[static_cast<size_t>(CommandType::Count)] = {};
+    uint64_t frames = 0;
+
+    void Record(CommandType type, uint64_t nanoseconds);
+};
+
+const char* GetCommandName(CommandType type);
+
+// Decodes one captured frame and re-issues it against backend. When stats is
+// given, every command is timed individually.
+bool ReplayFrame(const uint8_t* data, size_t size, ICommandBackend& backend, ReplayStats* stats);
@@ -0,0 +1,71 @@
+#include "FrameCapture.h"
+#include "NullBackend.h"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+// Replays a capture written by Renderer::StartCapture against the null
+// backend and reports per-command timings, so the submission path can be
+// measured on any platform.
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "Usage: FrameReplay <capture file> [iterations]\n";
+        return -1;
+    }
+
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 1;
+    if (iterations < 1) {
+        iterations = 1;
+    }
+
+    CaptureReader reader;
+    if (!reader.Open(argv[1])) {
+        std::cerr << "Failed to open capture " << argv[1] << "\n";
+        return -1;
+    }
+
+    std::vector<std::vector<uint8_t>> frames;
+    std::vector<uint8_t> frame;
+    while (reader.ReadFrame(frame)) {
+        frames.push_back(std::move(frame));
+    }
+
+    if (frames.empty()) {
+        std::cerr << "Capture contains no frames\n";
+        return -1;
+    }
+
+    ReplayStats stats;
+    NullBackend backend;
+    for (int i = 0; i < iterations; ++i) {
+        for (const auto& captured : frames) {
+            if (!ReplayFrame(captured.data(), captured.size(), backend, &stats)) {
+                std::cerr << "Capture is corrupt\n";
+                return -1;
+            }
+        }
+    }
+
+    const NullBackend::Counters& counters = backend.GetCounters();
+    std::cout << "Frames replayed: " << stats.frames << " (" << frames.size() << " captured)\n";
+    std::cout << "Draw calls: " << counters.drawCalls << ", indices: " << counters.indices
+        << ", invalid commands: " << counters.invalidCommands << "\n\n";
+
+    std::cout << std::left << std::setw(18) << "Command" << std::right
+        << std::setw(10) << "Count" << std::setw(14) << "Avg (ns)"
+        << std::setw(12) << "Min (ns)" << std::setw(12) << "Max (ns)" << "\n";
+
+    for (size_t i = 0; i < static_cast<size_t>(CommandType::Count); ++i) {
+        const CommandTiming& timing = stats.timings[i];
+        if (timing.count == 0) {
+            continue;
+        }
+        std::cout << std::left << std::setw(18) << GetCommandName(static_cast<CommandType>(i)) << std::right
+            << std::setw(10) << timing.count
+            << std::setw(14) << timing.totalNanoseconds / timing.count
+            << std::setw(12) << timing.minNanoseconds
+            << std::setw(12) << timing.maxNanoseconds << "\n";
+    }
+
+    return counters.invalidCommands == 0 ? 0 : 1;
+}
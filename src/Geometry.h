@@ -0,0 +1,62 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct Float3 {
+    float x, y, z;
+};
+
+struct Float4 {
+    float x, y, z, w;
+};
+
+struct Vertex {
+    Float3 position;
+    Float4 color;
+};
+
+// Non-owning view of geometry, e.g. a MeshData or a StaticMesh in static storage.
+struct MeshView {
+    const Vertex* vertices;
+    uint32_t vertexCount;
+    const uint32_t* indices;
+    uint32_t indexCount;
+
+    size_t GetSizeInBytes() const {
+        return vertexCount * sizeof(Vertex) + indexCount * sizeof(uint32_t);
+    }
+};
+
+// CPU-side geometry. Move-only so vertex and index arrays are never copied
+// by accident; Release frees the storage once the data lives on the GPU.
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+
+    MeshData() = default;
+    MeshData(MeshData&&) = default;
+    MeshData& operator=(MeshData&&) = default;
+    MeshData(const MeshData&) = delete;
+    MeshData& operator=(const MeshData&) = delete;
+
+    bool IsEmpty() const { return vertices.empty() || indices.empty(); }
+
+    size_t GetSizeInBytes() const {
+        return vertices.size() * sizeof(Vertex) + indices.size() * sizeof(uint32_t);
+    }
+
+    size_t GetCapacityInBytes() const {
+        return vertices.capacity() * sizeof(Vertex) + indices.capacity() * sizeof(uint32_t);
+    }
+
+    MeshView GetView() const {
+        return { vertices.data(), static_cast<uint32_t>(vertices.size()),
+            indices.data(), static_cast<uint32_t>(indices.size()) };
+    }
+
+    void Release() {
+        std::vector<Vertex>().swap(vertices);
+        std::vector<uint32_t>().swap(indices);
+    }
+};
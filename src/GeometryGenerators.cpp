@@ -0,0 +1,250 @@
+#include "GeometryGenerators.h"
+#include "Parallel.h"
+#include <cmath>
+#include <iostream>
+
+namespace {
+    constexpr float Pi = 3.14159265358979323846f;
+    constexpr uint32_t VerticesPerTask = 4096;
+
+    uint32_t RowGrain(uint32_t rowLength) {
+        return rowLength >= VerticesPerTask ? 1 : VerticesPerTask / rowLength;
+    }
+
+    void WriteGridQuads(uint32_t* indices, uint32_t base, uint32_t rowLength,
+        uint32_t columns, uint32_t row) {
+        uint32_t* out = indices + size_t(row) * columns * 6;
+        for (uint32_t column = 0; column < columns; ++column) {
+            GeometryDetail::WriteQuad(out, size_t(column) * 6, base, rowLength, column, row);
+        }
+    }
+}
+
+bool GenerateSphere(const SphereDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex) {
+    if (desc.slices == 0 || desc.stacks == 0) {
+        std::cerr << "Failed to generate sphere: zero slices or stacks\n";
+        return false;
+    }
+
+    uint32_t rowLength = desc.slices + 1;
+
+    ParallelFor(desc.stacks + 1, RowGrain(rowLength), [&](uint32_t begin, uint32_t end) {
+        for (uint32_t stack = begin; stack < end; ++stack) {
+            float phi = Pi * stack / desc.stacks;
+            float y = desc.radius * std::cos(phi);
+            float ring = desc.radius * std::sin(phi);
+
+            Vertex* row = vertices + size_t(stack) * rowLength;
+            for (uint32_t slice = 0; slice <= desc.slices; ++slice) {
+                float theta = 2.0f * Pi * slice / desc.slices;
+                row[slice] = { { ring * std::cos(theta), y, ring * std::sin(theta) }, desc.color };
+            }
+
+            if (stack < desc.stacks) {
+                WriteGridQuads(indices, baseVertex, rowLength, desc.slices, stack);
+            }
+        }
+    });
+
+    return true;
+}
+
+bool GenerateCylinder(const CylinderDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex) {
+    if (desc.slices == 0 || desc.stacks == 0) {
+        std::cerr << "Failed to generate cylinder: zero slices or stacks\n";
+        return false;
+    }
+
+    uint32_t rowLength = desc.slices + 1;
+    float half = desc.height / 2.0f;
+
+    // Side rows run from the top down so the shared quad winding faces outward.
+    ParallelFor(desc.stacks + 1, RowGrain(rowLength), [&](uint32_t begin, uint32_t end) {
+        for (uint32_t stack = begin; stack < end; ++stack) {
+            float y = half - desc.height * stack / desc.stacks;
+
+            Vertex* row = vertices + size_t(stack) * rowLength;
+            for (uint32_t slice = 0; slice <= desc.slices; ++slice) {
+                float theta = 2.0f * Pi * slice / desc.slices;
+                row[slice] = { { desc.radius * std::cos(theta), y, desc.radius * std::sin(theta) }, desc.color };
+            }
+
+            if (stack < desc.stacks) {
+                WriteGridQuads(indices, baseVertex, rowLength, desc.slices, stack);
+            }
+        }
+    });
+
+    uint32_t capVertices = desc.slices + 2;
+    uint32_t sideVertexCount = rowLength * (desc.stacks + 1);
+    size_t sideIndexCount = size_t(desc.slices) * desc.stacks * 6;
+
+    for (uint32_t cap = 0; cap < 2; ++cap) {
+        float y = cap == 0 ? half : -half;
+        uint32_t center = sideVertexCount + cap * capVertices;
+        Vertex* out = vertices + center;
+        uint32_t* capIndices = indices + sideIndexCount + size_t(cap) * desc.slices * 3;
+
+        out[0] = { { 0.0f, y, 0.0f }, desc.color };
+        for (uint32_t slice = 0; slice <= desc.slices; ++slice) {
+            float theta = 2.0f * Pi * slice / desc.slices;
+            out[slice + 1] = { { desc.radius * std::cos(theta), y, desc.radius * std::sin(theta) }, desc.color };
+        }
+
+        for (uint32_t slice = 0; slice < desc.slices; ++slice) {
+            uint32_t first = baseVertex + center + 1 + slice;
+            capIndices[slice * 3 + 0] = baseVertex + center;
+            capIndices[slice * 3 + 1] = cap == 0 ? first + 1 : first;
+            capIndices[slice * 3 + 2] = cap == 0 ? first : first + 1;
+        }
+    }
+
+    return true;
+}
+
+bool GenerateTorus(const TorusDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex) {
+    if (desc.majorSegments == 0 || desc.minorSegments == 0) {
+        std::cerr << "Failed to generate torus: zero segments\n";
+        return false;
+    }
+
+    uint32_t rowLength = desc.minorSegments + 1;
+
+    ParallelFor(desc.majorSegments + 1, RowGrain(rowLength), [&](uint32_t begin, uint32_t end) {
+        for (uint32_t major = begin; major < end; ++major) {
+            float theta = 2.0f * Pi * major / desc.majorSegments;
+            float cosTheta = std::cos(theta);
+            float sinTheta = std::sin(theta);
+
+            Vertex* row = vertices + size_t(major) * rowLength;
+            for (uint32_t minor = 0; minor <= desc.minorSegments; ++minor) {
+                float phi = 2.0f * Pi * minor / desc.minorSegments;
+                float ring = desc.majorRadius + desc.minorRadius * std::cos(phi);
+                row[minor] = { { ring * cosTheta, desc.minorRadius * std::sin(phi), ring * sinTheta }, desc.color };
+            }
+
+            if (major < desc.majorSegments) {
+                WriteGridQuads(indices, baseVertex, rowLength, desc.minorSegments, major);
+            }
+        }
+    });
+
+    return true;
+}
+
+bool GeneratePlaneGrid(const PlaneGridDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex) {
+    if (desc.columns == 0 || desc.rows == 0) {
+        std::cerr << "Failed to generate plane grid: zero columns or rows\n";
+        return false;
+    }
+
+    uint32_t rowLength = desc.columns + 1;
+
+    // Rows are laid out from +Z towards -Z so the shared quad winding faces +Y.
+    ParallelFor(desc.rows + 1, RowGrain(rowLength), [&](uint32_t begin, uint32_t end) {
+        for (uint32_t row = begin; row < end; ++row) {
+            float z = desc.depth / 2.0f - desc.depth * row / desc.rows;
+
+            Vertex* out = vertices + size_t(row) * rowLength;
+            for (uint32_t column = 0; column <= desc.columns; ++column) {
+                float x = -desc.width / 2.0f + desc.width * column / desc.columns;
+                out[column] = { { x, 0.0f, z }, desc.color };
+            }
+
+            if (row < desc.rows) {
+                WriteGridQuads(indices, baseVertex, rowLength, desc.columns, row);
+            }
+        }
+    });
+
+    return true;
+}
+
+bool GenerateSubdividedCube(const SubdividedCubeDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex) {
+    if (desc.subdivisions == 0) {
+        std::cerr << "Failed to generate cube: zero subdivisions\n";
+        return false;
+    }
+
+    uint32_t rowLength = desc.subdivisions + 1;
+    uint32_t faceVertices = rowLength * rowLength;
+    size_t faceIndices = size_t(desc.subdivisions) * desc.subdivisions * 6;
+    float half = desc.size / 2.0f;
+    float step = desc.size / desc.subdivisions;
+
+    ParallelFor(6 * rowLength, RowGrain(rowLength), [&](uint32_t begin, uint32_t end) {
+        for (uint32_t faceRow = begin; faceRow < end; ++faceRow) {
+            uint32_t f = faceRow / rowLength;
+            uint32_t row = faceRow % rowLength;
+            const GeometryDetail::CubeFace& face = GeometryDetail::CubeFaces[f];
+
+            Vertex* out = vertices + size_t(f) * faceVertices + size_t(row) * rowLength;
+            for (uint32_t column = 0; column <= desc.subdivisions; ++column) {
+                out[column] = { GeometryDetail::CubePoint(face, half,
+                    -half + column * step, -half + row * step), face.color };
+            }
+
+            if (row < desc.subdivisions) {
+                WriteGridQuads(indices + f * faceIndices, baseVertex + f * faceVertices,
+                    rowLength, desc.subdivisions, row);
+            }
+        }
+    });
+
+    return true;
+}
+
+MeshData CreateSphere(const SphereDesc& desc) {
+    GeometryCounts counts = GetSphereCounts(desc.slices, desc.stacks);
+    MeshData data;
+    data.vertices.resize(counts.vertexCount);
+    data.indices.resize(counts.indexCount);
+    if (!GenerateSphere(desc, data.vertices.data(), data.indices.data())) {
+        return MeshData();
+    }
+    return data;
+}
+
+MeshData CreateCylinder(const CylinderDesc& desc) {
+    GeometryCounts counts = GetCylinderCounts(desc.slices, desc.stacks);
+    MeshData data;
+    data.vertices.resize(counts.vertexCount);
+    data.indices.resize(counts.indexCount);
+    if (!GenerateCylinder(desc, data.vertices.data(), data.indices.data())) {
+        return MeshData();
+    }
+    return data;
+}
+
+MeshData CreateTorus(const TorusDesc& desc) {
+    GeometryCounts counts = GetTorusCounts(desc.majorSegments, desc.minorSegments);
+    MeshData data;
+    data.vertices.resize(counts.vertexCount);
+    data.indices.resize(counts.indexCount);
+    if (!GenerateTorus(desc, data.vertices.data(), data.indices.data())) {
+        return MeshData();
+    }
+    return data;
+}
+
+MeshData CreatePlaneGrid(const PlaneGridDesc& desc) {
+    GeometryCounts counts = GetPlaneGridCounts(desc.columns, desc.rows);
+    MeshData data;
+    data.vertices.resize(counts.vertexCount);
+    data.indices.resize(counts.indexCount);
+    if (!GeneratePlaneGrid(desc, data.vertices.data(), data.indices.data())) {
+        return MeshData();
+    }
+    return data;
+}
+
+MeshData CreateSubdividedCube(const SubdividedCubeDesc& desc) {
+    GeometryCounts counts = GetSubdividedCubeCounts(desc.subdivisions);
+    MeshData data;
+    data.vertices.resize(counts.vertexCount);
+    data.indices.resize(counts.indexCount);
+    if (!GenerateSubdividedCube(desc, data.vertices.data(), data.indices.data())) {
+        return MeshData();
+    }
+    return data;
+}
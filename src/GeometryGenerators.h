@@ -0,0 +1,239 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Geometry.h"
+
+struct GeometryCounts {
+    uint32_t vertexCount;
+    uint32_t indexCount;
+};
+
+// Geometry whose size is known at compile time. Instances built by the
+// constexpr generators below are emitted directly into static storage.
+template <size_t VertexCount, size_t IndexCount>
+struct StaticMesh {
+    std::array<Vertex, VertexCount> vertices;
+    std::array<uint32_t, IndexCount> indices;
+
+    constexpr MeshView GetView() const {
+        return { vertices.data(), static_cast<uint32_t>(VertexCount),
+            indices.data(), static_cast<uint32_t>(IndexCount) };
+    }
+};
+
+// Triangles are wound clockwise when seen from outside the surface, which is
+// the D3D12 default front face.
+namespace GeometryDetail {
+    struct CubeFace {
+        Float3 normal;
+        Float3 u;
+        Float3 v;
+        Float4 color;
+    };
+
+    constexpr CubeFace CubeFaces[6] = {
+        { {  0,  0,  1 }, { 1, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0, 1 } },
+        { {  0,  0, -1 }, { 0, 1, 0 }, { 1, 0, 0 }, { 0, 1, 0, 1 } },
+        { {  0,  1,  0 }, { 0, 0, 1 }, { 1, 0, 0 }, { 0, 0, 1, 1 } },
+        { {  0, -1,  0 }, { 1, 0, 0 }, { 0, 0, 1 }, { 1, 1, 0, 1 } },
+        { {  1,  0,  0 }, { 0, 1, 0 }, { 0, 0, 1 }, { 0, 1, 1, 1 } },
+        { { -1,  0,  0 }, { 0, 0, 1 }, { 0, 1, 0 }, { 1, 0, 1, 1 } },
+    };
+
+    constexpr Float3 CubePoint(const CubeFace& face, float half, float s, float t) {
+        return {
+            face.normal.x * half + face.u.x * s + face.v.x * t,
+            face.normal.y * half + face.u.y * s + face.v.y * t,
+            face.normal.z * half + face.u.z * s + face.v.z * t,
+        };
+    }
+
+    // Writes the two triangles of the grid quad whose corner is (column, row)
+    // in a grid that is rowLength vertices wide.
+    template <typename IndexArray>
+    constexpr void WriteQuad(IndexArray& indices, size_t offset, uint32_t base,
+        uint32_t rowLength, uint32_t column, uint32_t row) {
+        uint32_t a = base + row * rowLength + column;
+        uint32_t b = a + 1;
+        uint32_t c = a + rowLength + 1;
+        uint32_t d = a + rowLength;
+        indices[offset + 0] = a;
+        indices[offset + 1] = b;
+        indices[offset + 2] = c;
+        indices[offset + 3] = a;
+        indices[offset + 4] = c;
+        indices[offset + 5] = d;
+    }
+}
+
+constexpr GeometryCounts GetSubdividedCubeCounts(uint32_t subdivisions) {
+    return { 6 * (subdivisions + 1) * (subdivisions + 1), 6 * subdivisions * subdivisions * 6 };
+}
+
+constexpr GeometryCounts GetPlaneGridCounts(uint32_t columns, uint32_t rows) {
+    return { (columns + 1) * (rows + 1), columns * rows * 6 };
+}
+
+constexpr GeometryCounts GetSphereCounts(uint32_t slices, uint32_t stacks) {
+    return { (slices + 1) * (stacks + 1), slices * stacks * 6 };
+}
+
+constexpr GeometryCounts GetCylinderCounts(uint32_t slices, uint32_t stacks) {
+    return { (slices + 1) * (stacks + 1) + 2 * (slices + 2), slices * stacks * 6 + 2 * slices * 3 };
+}
+
+constexpr GeometryCounts GetTorusCounts(uint32_t majorSegments, uint32_t minorSegments) {
+    return { (majorSegments + 1) * (minorSegments + 1), majorSegments * minorSegments * 6 };
+}
+
+template <uint32_t Subdivisions>
+constexpr auto MakeSubdividedCube(float size) {
+    static_assert(Subdivisions > 0, "A cube needs at least one subdivision per edge");
+    constexpr GeometryCounts counts = GetSubdividedCubeCounts(Subdivisions);
+    constexpr uint32_t rowLength = Subdivisions + 1;
+
+    StaticMesh<counts.vertexCount, counts.indexCount> mesh = {};
+    float half = size / 2.0f;
+    float step = size / Subdivisions;
+    size_t vertex = 0;
+    size_t index = 0;
+
+    for (uint32_t f = 0; f < 6; ++f) {
+        const GeometryDetail::CubeFace& face = GeometryDetail::CubeFaces[f];
+        uint32_t base = static_cast<uint32_t>(vertex);
+
+        for (uint32_t row = 0; row <= Subdivisions; ++row) {
+            for (uint32_t column = 0; column <= Subdivisions; ++column) {
+                Float3 position = GeometryDetail::CubePoint(face, half,
+                    -half + column * step, -half + row * step);
+                mesh.vertices[vertex++] = { position, face.color };
+            }
+        }
+
+        for (uint32_t row = 0; row < Subdivisions; ++row) {
+            for (uint32_t column = 0; column < Subdivisions; ++column) {
+                GeometryDetail::WriteQuad(mesh.indices, index, base, rowLength, column, row);
+                index += 6;
+            }
+        }
+    }
+
+    return mesh;
+}
+
+// Grid in the XZ plane centred on the origin, facing +Y.
+template <uint32_t Columns, uint32_t Rows>
+constexpr auto MakePlaneGrid(float width, float depth, Float4 color) {
+    static_assert(Columns > 0 && Rows > 0, "A grid needs at least one cell");
+    constexpr GeometryCounts counts = GetPlaneGridCounts(Columns, Rows);
+
+    StaticMesh<counts.vertexCount, counts.indexCount> mesh = {};
+    size_t vertex = 0;
+    size_t index = 0;
+
+    // Rows are laid out from +Z towards -Z so the shared quad winding faces +Y.
+    for (uint32_t row = 0; row <= Rows; ++row) {
+        for (uint32_t column = 0; column <= Columns; ++column) {
+            Float3 position = { -width / 2.0f + width * column / Columns, 0.0f,
+                depth / 2.0f - depth * row / Rows };
+            mesh.vertices[vertex++] = { position, color };
+        }
+    }
+
+    for (uint32_t row = 0; row < Rows; ++row) {
+        for (uint32_t column = 0; column < Columns; ++column) {
+            GeometryDetail::WriteQuad(mesh.indices, index, 0, Columns + 1, column, row);
+            index += 6;
+        }
+    }
+
+    return mesh;
+}
+
+constexpr StaticMesh<5, 18> MakePyramid(float size) {
+    float half = size / 2.0f;
+    return {
+        { {
+            { {  0,  half,  0 }, { 1, 1, 0, 1 } },
+            { { -half, -half,  half }, { 1, 0, 0, 1 } },
+            { {  half, -half,  half }, { 1, 0, 0, 1 } },
+            { {  half, -half, -half }, { 0, 1, 0, 1 } },
+            { { -half, -half, -half }, { 0, 1, 0, 1 } },
+        } },
+        { {
+            0, 1, 2,
+            0, 2, 3,
+            0, 3, 4,
+            0, 4, 1,
+            1, 3, 2,
+            1, 4, 3
+        } }
+    };
+}
+
+inline constexpr auto UnitCube = MakeSubdividedCube<1>(1.0f);
+inline constexpr auto UnitPyramid = MakePyramid(1.0f);
+
+template <size_t VertexCount, size_t IndexCount>
+MeshData ToMeshData(const StaticMesh<VertexCount, IndexCount>& mesh) {
+    MeshData data;
+    data.vertices.assign(mesh.vertices.begin(), mesh.vertices.end());
+    data.indices.assign(mesh.indices.begin(), mesh.indices.end());
+    return data;
+}
+
+struct SphereDesc {
+    float radius;
+    uint32_t slices;
+    uint32_t stacks;
+    Float4 color;
+};
+
+struct CylinderDesc {
+    float radius;
+    float height;
+    uint32_t slices;
+    uint32_t stacks;
+    Float4 color;
+};
+
+struct TorusDesc {
+    float majorRadius;
+    float minorRadius;
+    uint32_t majorSegments;
+    uint32_t minorSegments;
+    Float4 color;
+};
+
+struct PlaneGridDesc {
+    float width;
+    float depth;
+    uint32_t columns;
+    uint32_t rows;
+    Float4 color;
+};
+
+struct SubdividedCubeDesc {
+    float size;
+    uint32_t subdivisions;
+};
+
+// Runtime generators for parameterised shapes. Each writes exactly the
+// number of vertices and indices reported by the matching Get*Counts into
+// caller-provided memory (a MeshData, a mapped upload buffer, ...), splitting
+// the work across rows with ParallelFor. baseVertex is added to every index.
+// A zero slice, stack, segment, row or subdivision count is rejected and
+// nothing is written.
+bool GenerateSphere(const SphereDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex = 0);
+bool GenerateCylinder(const CylinderDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex = 0);
+bool GenerateTorus(const TorusDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex = 0);
+bool GeneratePlaneGrid(const PlaneGridDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex = 0);
+bool GenerateSubdividedCube(const SubdividedCubeDesc& desc, Vertex* vertices, uint32_t* indices, uint32_t baseVertex = 0);
+
+// The Create* helpers return an empty mesh when the desc is rejected.
+MeshData CreateSphere(const SphereDesc& desc);
+MeshData CreateCylinder(const CylinderDesc& desc);
+MeshData CreateTorus(const TorusDesc& desc);
+MeshData CreatePlaneGrid(const PlaneGridDesc& desc);
+MeshData CreateSubdividedCube(const SubdividedCubeDesc& desc);
@@ -0,0 +1,146 @@
+#include "GeometryPool.h"
+#include <cstring>
+
+GeometryPool::GeometryPool()
+    : m_mappedVertices(nullptr), m_mappedIndices(nullptr),
+    m_vertexBufferView({}), m_indexBufferView({}), m_capture(nullptr) {}
+
+GeometryPool::~GeometryPool() {
+    Shutdown();
+}
+
+bool GeometryPool::Initialize(ID3D12Device* device, uint32_t maxVertices, uint32_t maxIndices) {
+    if (!CreateBuffer(device, UINT64(maxVertices) * sizeof(Vertex), m_vertexBuffer,
+        reinterpret_cast<void**>(&m_mappedVertices))) {
+        return false;
+    }
+
+    if (!CreateBuffer(device, UINT64(maxIndices) * sizeof(uint32_t), m_indexBuffer,
+        reinterpret_cast<void**>(&m_mappedIndices))) {
+        return false;
+    }
+
+    m_vertexRanges.Reset(maxVertices);
+    m_indexRanges.Reset(maxIndices);
+
+    m_vertexBufferView.BufferLocation = m_vertexBuffer->GetGPUVirtualAddress();
+    m_vertexBufferView.SizeInBytes = maxVertices * sizeof(Vertex);
+    m_vertexBufferView.StrideInBytes = sizeof(Vertex);
+
+    m_indexBufferView.BufferLocation = m_indexBuffer->GetGPUVirtualAddress();
+    m_indexBufferView.SizeInBytes = maxIndices * sizeof(uint32_t);
+    m_indexBufferView.Format = DXGI_FORMAT_R32_UINT;
+
+    return true;
+}
+
+bool GeometryPool::CreateBuffer(ID3D12Device* device, UINT64 size,
+    ComPtr<ID3D12Resource>& buffer, void** mapped) {
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = size;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    if (FAILED(device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE,
+        &bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+        IID_PPV_ARGS(&buffer)))) {
+        return false;
+    }
+
+    D3D12_RANGE readRange = { 0, 0 };
+    if (FAILED(buffer->Map(0, &readRange, mapped))) {
+        return false;
+    }
+
+    return true;
+}
+
+bool GeometryPool::Upload(const MeshView& mesh, GpuMeshRange& range) {
+    uint32_t vertexCount = mesh.vertexCount;
+    uint32_t indexCount = mesh.indexCount;
+
+    uint32_t vertexOffset = 0;
+    if (!m_vertexRanges.Allocate(vertexCount, vertexOffset)) {
+        return false;
+    }
+
+    uint32_t indexOffset = 0;
+    if (!m_indexRanges.Allocate(indexCount, indexOffset)) {
+        m_vertexRanges.Free(vertexOffset, vertexCount);
+        return false;
+    }
+
+    std::memcpy(m_mappedVertices + vertexOffset, mesh.vertices, vertexCount * sizeof(Vertex));
+    std::memcpy(m_mappedIndices + indexOffset, mesh.indices, indexCount * sizeof(uint32_t));
+
+    if (m_capture) {
+        m_capture->UploadBuffer(VertexBufferId, UINT64(vertexOffset) * sizeof(Vertex),
+            mesh.vertices, vertexCount * sizeof(Vertex));
+        m_capture->UploadBuffer(IndexBufferId, UINT64(indexOffset) * sizeof(uint32_t),
+            mesh.indices, indexCount * sizeof(uint32_t));
+    }
+
+    range.vertexOffset = vertexOffset;
+    range.vertexCount = vertexCount;
+    range.indexOffset = indexOffset;
+    range.indexCount = indexCount;
+    return true;
+}
+
+void GeometryPool::Evict(const GpuMeshRange& range) {
+    m_vertexRanges.Free(range.vertexOffset, range.vertexCount);
+    m_indexRanges.Free(range.indexOffset, range.indexCount);
+}
+
+void GeometryPool::RecordSnapshot(ICommandBackend& capture) const {
+    BufferDesc vertexDesc = {};
+    vertexDesc.bufferId = VertexBufferId;
+    vertexDesc.usage = BufferUsage::Vertex;
+    vertexDesc.sizeInBytes = m_vertexBufferView.SizeInBytes;
+    vertexDesc.gpuAddress = m_vertexBufferView.BufferLocation;
+    vertexDesc.stride = m_vertexBufferView.StrideInBytes;
+    capture.CreateBuffer(vertexDesc);
+
+    BufferDesc indexDesc = {};
+    indexDesc.bufferId = IndexBufferId;
+    indexDesc.usage = BufferUsage::Index;
+    indexDesc.sizeInBytes = m_indexBufferView.SizeInBytes;
+    indexDesc.gpuAddress = m_indexBufferView.BufferLocation;
+    indexDesc.format = m_indexBufferView.Format;
+    capture.CreateBuffer(indexDesc);
+
+    // Everything past the high-water mark has never been written. Reading
+    // the write-combined upload heap is slow, but only happens once per capture.
+    capture.UploadBuffer(VertexBufferId, 0, m_mappedVertices,
+        m_vertexRanges.GetHighWaterMark() * sizeof(Vertex));
+    capture.UploadBuffer(IndexBufferId, 0, m_mappedIndices,
+        m_indexRanges.GetHighWaterMark() * sizeof(uint32_t));
+}
+
+void GeometryPool::Shutdown() {
+    m_capture = nullptr;
+
+    if (m_vertexBuffer && m_mappedVertices) {
+        m_vertexBuffer->Unmap(0, nullptr);
+        m_mappedVertices = nullptr;
+    }
+    if (m_indexBuffer && m_mappedIndices) {
+        m_indexBuffer->Unmap(0, nullptr);
+        m_mappedIndices = nullptr;
+    }
+
+    m_vertexBuffer.Reset();
+    m_indexBuffer.Reset();
+    m_vertexRanges.Reset(0);
+    m_indexRanges.Reset(0);
+}
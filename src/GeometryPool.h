@@ -0,0 +1,55 @@
+#pragma once
+#include <d3d12.h>
+#include <wrl/client.h>
+#include "CommandBackend.h"
+#include "RangeAllocator.h"
+#include "ResidencyManager.h"
+
+using Microsoft::WRL::ComPtr;
+
+// One shared vertex buffer and one shared index buffer that all meshes are
+// sub-allocated from. Both live in a persistently mapped upload heap, so an
+// upload is a memcpy and every draw can use the same buffer views.
+//
+// Both buffers are committed in full by Initialize and stay committed until
+// Shutdown. Evict only returns a range to the allocators for reuse, so the
+// residency budget limits how much of the pool is occupied, not how much GPU
+// memory the pool holds; size maxVertices and maxIndices for the memory you
+// are willing to commit.
+class GeometryPool : public IGeometryDevice {
+public:
+    static constexpr uint32_t VertexBufferId = 0;
+    static constexpr uint32_t IndexBufferId = 1;
+
+    GeometryPool();
+    ~GeometryPool();
+
+    bool Initialize(ID3D12Device* device, uint32_t maxVertices, uint32_t maxIndices);
+    void Shutdown();
+
+    bool Upload(const MeshView& mesh, GpuMeshRange& range) override;
+    void Evict(const GpuMeshRange& range) override;
+
+    // Records both buffers and their used contents, then forwards every
+    // later upload to capture until SetCapture(nullptr).
+    void RecordSnapshot(ICommandBackend& capture) const;
+    void SetCapture(ICommandBackend* capture) { m_capture = capture; }
+
+    const D3D12_VERTEX_BUFFER_VIEW& GetVertexBufferView() const { return m_vertexBufferView; }
+    const D3D12_INDEX_BUFFER_VIEW& GetIndexBufferView() const { return m_indexBufferView; }
+
+private:
+    bool CreateBuffer(ID3D12Device* device, UINT64 size, ComPtr<ID3D12Resource>& buffer, void** mapped);
+
+    ComPtr<ID3D12Resource> m_vertexBuffer;
+    ComPtr<ID3D12Resource> m_indexBuffer;
+    Vertex* m_mappedVertices;
+    uint32_t* m_mappedIndices;
+
+    RangeAllocator m_vertexRanges;
+    RangeAllocator m_indexRanges;
+
+    D3D12_VERTEX_BUFFER_VIEW m_vertexBufferView;
+    D3D12_INDEX_BUFFER_VIEW m_indexBufferView;
+    ICommandBackend* m_capture;
+};
@@ -0,0 +1,37 @@
+#include "IndirectDraw.h"
+
+IndirectArgumentPacker::IndirectArgumentPacker()
+    : m_arguments(nullptr), m_capacity(0), m_count(0) {}
+
+void IndirectArgumentPacker::Begin(IndirectDrawCommand* arguments, uint32_t capacity) {
+    m_arguments = arguments;
+    m_capacity = arguments ? capacity : 0;
+    m_count = 0;
+}
+
+bool IndirectArgumentPacker::Push(const IndirectDrawCommand& command) {
+    if (m_count >= m_capacity) {
+        return false;
+    }
+
+    m_arguments[m_count++] = command;
+    return true;
+}
+
+uint32_t IndirectArgumentPacker::Finish(uint32_t* countBuffer) {
+    if (countBuffer) {
+        *countBuffer = m_count;
+    }
+    return m_count;
+}
+
+uint32_t CompactDrawCommands(const IndirectDrawCommand* commands, const uint8_t* visibility,
+    uint32_t count, IndirectDrawCommand* output) {
+    uint32_t written = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (visibility[i]) {
+            output[written++] = commands[i];
+        }
+    }
+    return written;
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include <cstdint>
+
+// Portable mirrors of the D3D12 indirect argument structures so the packing
+// and compaction logic can be built and exercised without the D3D12 headers.
+struct DrawIndexedArguments {
+    uint32_t indexCountPerInstance;
+    uint32_t instanceCount;
+    uint32_t startIndexLocation;
+    int32_t baseVertexLocation;
+    uint32_t startInstanceLocation;
+};
+
+// One record of the argument buffer consumed by ExecuteIndirect. Every mesh
+// lives in the pooled vertex and index buffers, which are bound once per
+// frame, so the command signature built in
+// Renderer::CreateIndirectResources carries only the draw arguments.
+struct IndirectDrawCommand {
+    DrawIndexedArguments draw;
+};
+
+static_assert(sizeof(IndirectDrawCommand) == 20, "IndirectDrawCommand must match the command signature stride");
+
+// Writes draw commands straight into a caller-owned (typically persistently
+// mapped upload) argument buffer and produces the matching count value.
+class IndirectArgumentPacker {
+public:
+    IndirectArgumentPacker();
+
+    void Begin(IndirectDrawCommand* arguments, uint32_t capacity);
+    bool Push(const IndirectDrawCommand& command);
+    uint32_t Finish(uint32_t* countBuffer);
+
+    uint32_t GetCount() const { return m_count; }
+    uint32_t GetCapacity() const { return m_capacity; }
+
+private:
+    IndirectDrawCommand* m_arguments;
+    uint32_t m_capacity;
+    uint32_t m_count;
+};
+
+// CPU reference for the GPU compaction pass: copies every command whose
+// visibility flag is non-zero into output, preserving order, and returns the
+// number written. output must have room for count commands.
+uint32_t CompactDrawCommands(const IndirectDrawCommand* commands, const uint8_t* visibility,
+    uint32_t count, IndirectDrawCommand* output);
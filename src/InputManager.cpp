@@ -1,6 +1,10 @@
 #include "InputManager.h"
 #include <cstring>
 
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
 InputManager::InputManager() {
     std::memset(m_keyStates, 0, sizeof(m_keyStates));
     std::memset(m_prevKeyStates, 0, sizeof(m_prevKeyStates));
@@ -11,9 +15,17 @@ InputManager::~InputManager() {}
 void InputManager::Update() {
     std::memcpy(m_prevKeyStates, m_keyStates, sizeof(m_keyStates));
     
-    for (int i = 0; i < 256; ++i) {
+#ifdef _WIN32
+    for (int i = 0; i < KeyCount; ++i) {
         m_keyStates[i] = (GetAsyncKeyState(i) & 0x8000) != 0;
     }
+#endif
+}
+
+void InputManager::SetKeyState(int key, bool down) {
+    if (key >= 0 && key < KeyCount) {
+        m_keyStates[key] = down;
+    }
 }
 
 bool InputManager::IsKeyPressed(int key) const {
@@ -26,4 +38,4 @@ bool InputManager::IsKeyDown(int key) const {
 
 bool InputManager::IsKeyReleased(int key) const {
     return !m_keyStates[key] && m_prevKeyStates[key];
-}
\ No newline at end of file
+}
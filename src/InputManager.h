@@ -1,18 +1,23 @@
 #pragma once
-#include <Windows.h>
 
+// Keeps current and previous key state so presses and releases can be
+// detected per frame. On Windows Update polls the keyboard; elsewhere (and
+// in tools and benchmarks) state is fed in with SetKeyState.
 class InputManager {
 public:
+    static constexpr int KeyCount = 256;
+
     InputManager();
     ~InputManager();
 
     void Update();
+    void SetKeyState(int key, bool down);
 
     bool IsKeyPressed(int key) const;
     bool IsKeyDown(int key) const;
     bool IsKeyReleased(int key) const;
 
 private:
-    bool m_keyStates[256];
-    bool m_prevKeyStates[256];
-};
\ No newline at end of file
+    bool m_keyStates[KeyCount];
+    bool m_prevKeyStates[KeyCount];
+};
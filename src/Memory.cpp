@@ -0,0 +1,326 @@
+#include "Memory.h"
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+    constexpr size_t TagCount = static_cast<size_t>(MemoryTag::Count);
+    constexpr size_t ThreadArenaCapacity = 1024 * 1024;
+
+    struct TagCounters {
+        std::atomic<uint64_t> currentBytes{ 0 };
+        std::atomic<uint64_t> peakBytes{ 0 };
+        std::atomic<uint64_t> totalAllocations{ 0 };
+        std::atomic<uint64_t> frameAllocations{ 0 };
+    };
+
+    TagCounters g_counters[TagCount];
+
+    const char* g_tagNames[TagCount] = {
+        "General",
+        "Renderer",
+        "Geometry",
+        "Scene",
+        "Scratch",
+    };
+
+    size_t AlignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) & ~(alignment - 1);
+    }
+
+    // Goes straight to the C runtime so tracked allocations are not counted
+    // a second time by the ENGINE_TRACK_GLOBAL_HEAP operator new.
+    void* AlignedMalloc(size_t size, size_t alignment) {
+        alignment = alignment < sizeof(void*) ? sizeof(void*) : alignment;
+#ifdef _WIN32
+        return _aligned_malloc(size ? size : 1, alignment);
+#else
+        return std::aligned_alloc(alignment, AlignUp(size ? size : 1, alignment));
+#endif
+    }
+
+    void AlignedFree(void* ptr) {
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+
+    // PoolAllocator keeps one state byte per block after the blocks.
+    constexpr unsigned char BlockFree = 0;
+    constexpr unsigned char BlockUsed = 1;
+}
+
+void MemoryTracker::RecordAllocation(MemoryTag tag, size_t size) {
+    TagCounters& counters = g_counters[static_cast<size_t>(tag)];
+    uint64_t current = counters.currentBytes.fetch_add(size, std::memory_order_relaxed) + size;
+    uint64_t peak = counters.peakBytes.load(std::memory_order_relaxed);
+    while (current > peak &&
+        !counters.peakBytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {
+    }
+    counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+    counters.frameAllocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void MemoryTracker::RecordFree(MemoryTag tag, size_t size) {
+    g_counters[static_cast<size_t>(tag)].currentBytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+void MemoryTracker::BeginFrame() {
+    for (auto& counters : g_counters) {
+        counters.frameAllocations.store(0, std::memory_order_relaxed);
+    }
+}
+
+MemoryTagStats MemoryTracker::GetStats(MemoryTag tag) {
+    const TagCounters& counters = g_counters[static_cast<size_t>(tag)];
+    MemoryTagStats stats = {};
+    stats.currentBytes = counters.currentBytes.load(std::memory_order_relaxed);
+    stats.peakBytes = counters.peakBytes.load(std::memory_order_relaxed);
+    stats.totalAllocations = counters.totalAllocations.load(std::memory_order_relaxed);
+    stats.frameAllocations = counters.frameAllocations.load(std::memory_order_relaxed);
+    return stats;
+}
+
+uint64_t MemoryTracker::GetFrameAllocations() {
+    uint64_t total = 0;
+    for (const auto& counters : g_counters) {
+        total += counters.frameAllocations.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t MemoryTracker::GetCurrentBytes() {
+    uint64_t total = 0;
+    for (const auto& counters : g_counters) {
+        total += counters.currentBytes.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+const char* MemoryTracker::GetTagName(MemoryTag tag) {
+    size_t index = static_cast<size_t>(tag);
+    return index < TagCount ? g_tagNames[index] : "Unknown";
+}
+
+uint64_t FrameAllocationMonitor::EndFrame() {
+    uint64_t allocations = MemoryTracker::GetFrameAllocations();
+    if (++m_frames <= m_warmupFrames || allocations == 0) {
+        return 0;
+    }
+
+    ++m_allocatingFrames;
+    m_steadyStateAllocations += allocations;
+    return allocations;
+}
+
+void* TrackedAllocate(size_t size, size_t alignment, MemoryTag tag) {
+    void* ptr = AlignedMalloc(size, alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    MemoryTracker::RecordAllocation(tag, size);
+    return ptr;
+}
+
+void TrackedFree(void* ptr, size_t size, size_t, MemoryTag tag) {
+    if (!ptr) {
+        return;
+    }
+    AlignedFree(ptr);
+    MemoryTracker::RecordFree(tag, size);
+}
+
+LinearArena::LinearArena(size_t capacity, MemoryTag tag)
+    : m_buffer(static_cast<unsigned char*>(TrackedAllocate(capacity, alignof(std::max_align_t), tag))),
+    m_capacity(capacity), m_offset(0), m_peak(0), m_tag(tag) {}
+
+LinearArena::~LinearArena() {
+    TrackedFree(m_buffer, m_capacity, alignof(std::max_align_t), m_tag);
+}
+
+void* LinearArena::Allocate(size_t size, size_t alignment) {
+    size_t address = reinterpret_cast<size_t>(m_buffer) + m_offset;
+    size_t start = AlignUp(address, alignment) - reinterpret_cast<size_t>(m_buffer);
+    if (start + size > m_capacity) {
+        return nullptr;
+    }
+
+    m_offset = start + size;
+    if (m_offset > m_peak) {
+        m_peak = m_offset;
+    }
+    return m_buffer + start;
+}
+
+LinearArena& GetThreadArena() {
+    thread_local LinearArena arena(ThreadArenaCapacity);
+    return arena;
+}
+
+PoolAllocator::PoolAllocator(size_t blockSize, size_t blockCount, MemoryTag tag)
+    : m_buffer(nullptr), m_freeList(nullptr),
+    m_blockSize(AlignUp(blockSize < sizeof(void*) ? sizeof(void*) : blockSize, alignof(std::max_align_t))),
+    m_blockCount(blockCount), m_usedBlocks(0), m_tag(tag) {
+    m_buffer = static_cast<unsigned char*>(
+        TrackedAllocate(m_blockSize * m_blockCount + m_blockCount, alignof(std::max_align_t), m_tag));
+    std::memset(m_buffer + m_blockSize * m_blockCount, BlockFree, m_blockCount);
+
+    for (size_t i = m_blockCount; i > 0; --i) {
+        void* block = m_buffer + (i - 1) * m_blockSize;
+        *static_cast<void**>(block) = m_freeList;
+        m_freeList = block;
+    }
+}
+
+PoolAllocator::~PoolAllocator() {
+    TrackedFree(m_buffer, m_blockSize * m_blockCount + m_blockCount, alignof(std::max_align_t), m_tag);
+}
+
+unsigned char& PoolAllocator::GetState(const void* block) const {
+    size_t index = (static_cast<const unsigned char*>(block) - m_buffer) / m_blockSize;
+    return m_buffer[m_blockSize * m_blockCount + index];
+}
+
+void* PoolAllocator::Allocate() {
+    if (!m_freeList) {
+        return nullptr;
+    }
+
+    void* block = m_freeList;
+    m_freeList = *static_cast<void**>(block);
+    GetState(block) = BlockUsed;
+    ++m_usedBlocks;
+    return block;
+}
+
+void PoolAllocator::Free(void* block) {
+    if (!block || !Owns(block)) {
+        return;
+    }
+
+    // A second Free would link the block into the free list twice and hand
+    // it out to two owners; release builds ignore it.
+    unsigned char& state = GetState(block);
+    assert(state == BlockUsed && "PoolAllocator::Free called twice on the same block");
+    if (state != BlockUsed) {
+        return;
+    }
+    state = BlockFree;
+
+    *static_cast<void**>(block) = m_freeList;
+    m_freeList = block;
+    --m_usedBlocks;
+}
+
+bool PoolAllocator::Owns(const void* block) const {
+    const unsigned char* ptr = static_cast<const unsigned char*>(block);
+    return ptr >= m_buffer && ptr < m_buffer + m_blockSize * m_blockCount &&
+        (ptr - m_buffer) % m_blockSize == 0;
+}
+
+void* ArenaMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    void* ptr = m_arena.Allocate(bytes, alignment);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+bool ArenaMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    const auto* resource = dynamic_cast<const ArenaMemoryResource*>(&other);
+    return resource && &resource->m_arena == &m_arena;
+}
+
+void* TrackingMemoryResource::do_allocate(size_t bytes, size_t alignment) {
+    return TrackedAllocate(bytes, alignment, m_tag);
+}
+
+void TrackingMemoryResource::do_deallocate(void* ptr, size_t bytes, size_t alignment) {
+    TrackedFree(ptr, bytes, alignment, m_tag);
+}
+
+bool TrackingMemoryResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    const auto* resource = dynamic_cast<const TrackingMemoryResource*>(&other);
+    return resource && resource->m_tag == m_tag;
+}
+
+#ifdef ENGINE_TRACK_GLOBAL_HEAP
+// Optional global operator new/delete replacement so untagged heap traffic
+// (std::vector growth, std::string, ...) is counted under MemoryTag::General.
+// Every form is replaced (array, nothrow, aligned) so nothing slips past the
+// steady-state check. The requested size is stored just before the block.
+namespace {
+    constexpr size_t HeapHeaderSize = alignof(std::max_align_t);
+
+    size_t GetHeapOffset(size_t alignment) {
+        return alignment > HeapHeaderSize ? alignment : HeapHeaderSize;
+    }
+
+    void* HeapTryAllocate(size_t size, size_t alignment) {
+        size_t offset = GetHeapOffset(alignment);
+        unsigned char* raw = static_cast<unsigned char*>(AlignedMalloc(size + offset, offset));
+        if (!raw) {
+            return nullptr;
+        }
+        unsigned char* ptr = raw + offset;
+        std::memcpy(ptr - sizeof(size_t), &size, sizeof(size_t));
+        MemoryTracker::RecordAllocation(MemoryTag::General, size);
+        return ptr;
+    }
+
+    void* HeapAllocate(size_t size, size_t alignment) {
+        void* ptr = HeapTryAllocate(size, alignment);
+        if (!ptr) {
+            throw std::bad_alloc();
+        }
+        return ptr;
+    }
+
+    void HeapFree(void* ptr, size_t alignment) {
+        if (!ptr) {
+            return;
+        }
+        unsigned char* block = static_cast<unsigned char*>(ptr);
+        size_t size;
+        std::memcpy(&size, block - sizeof(size_t), sizeof(size_t));
+        MemoryTracker::RecordFree(MemoryTag::General, size);
+        AlignedFree(block - GetHeapOffset(alignment));
+    }
+
+    constexpr size_t DefaultAlignment = alignof(std::max_align_t);
+}
+
+void* operator new(size_t size) { return HeapAllocate(size, DefaultAlignment); }
+void* operator new[](size_t size) { return HeapAllocate(size, DefaultAlignment); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return HeapTryAllocate(size, DefaultAlignment); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return HeapTryAllocate(size, DefaultAlignment); }
+void* operator new(size_t size, std::align_val_t alignment) { return HeapAllocate(size, size_t(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return HeapAllocate(size, size_t(alignment)); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return HeapTryAllocate(size, size_t(alignment));
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return HeapTryAllocate(size, size_t(alignment));
+}
+
+void operator delete(void* ptr) noexcept { HeapFree(ptr, DefaultAlignment); }
+void operator delete[](void* ptr) noexcept { HeapFree(ptr, DefaultAlignment); }
+void operator delete(void* ptr, size_t) noexcept { HeapFree(ptr, DefaultAlignment); }
+void operator delete[](void* ptr, size_t) noexcept { HeapFree(ptr, DefaultAlignment); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { HeapFree(ptr, DefaultAlignment); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { HeapFree(ptr, DefaultAlignment); }
+void operator delete(void* ptr, std::align_val_t alignment) noexcept { HeapFree(ptr, size_t(alignment)); }
+void operator delete[](void* ptr, std::align_val_t alignment) noexcept { HeapFree(ptr, size_t(alignment)); }
+void operator delete(void* ptr, size_t, std::align_val_t alignment) noexcept { HeapFree(ptr, size_t(alignment)); }
+void operator delete[](void* ptr, size_t, std::align_val_t alignment) noexcept { HeapFree(ptr, size_t(alignment)); }
+void operator delete(void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    HeapFree(ptr, size_t(alignment));
+}
+void operator delete[](void* ptr, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    HeapFree(ptr, size_t(alignment));
+}
+#endif
@@ -0,0 +1,197 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+
+enum class MemoryTag : uint8_t {
+    General,
+    Renderer,
+    Geometry,
+    Scene,
+    Scratch,
+    Count
+};
+
+struct MemoryTagStats {
+    uint64_t currentBytes;
+    uint64_t peakBytes;
+    uint64_t totalAllocations;
+    uint64_t frameAllocations;
+};
+
+// Process-wide allocation counters per subsystem tag. All counters are
+// atomic, so any thread may record; BeginFrame is called once per frame by
+// the engine loop to reset the per-frame allocation counts.
+class MemoryTracker {
+public:
+    static void RecordAllocation(MemoryTag tag, size_t size);
+    static void RecordFree(MemoryTag tag, size_t size);
+    static void BeginFrame();
+
+    static MemoryTagStats GetStats(MemoryTag tag);
+    static uint64_t GetFrameAllocations();
+    static uint64_t GetCurrentBytes();
+    static const char* GetTagName(MemoryTag tag);
+};
+
+// Watches for heap traffic once the engine has reached steady state. Call
+// EndFrame after each frame (before MemoryTracker::BeginFrame resets the
+// counts); frames after the warm-up that recorded any tracked allocation are
+// counted. With ENGINE_TRACK_GLOBAL_HEAP every new/delete is tracked, so a
+// zero count means the frame loop never touched the heap.
+class FrameAllocationMonitor {
+public:
+    explicit FrameAllocationMonitor(uint64_t warmupFrames) : m_warmupFrames(warmupFrames) {}
+
+    // Returns the frame's allocation count if it is past the warm-up and
+    // allocated, zero otherwise.
+    uint64_t EndFrame();
+
+    uint64_t GetFrames() const { return m_frames; }
+    uint64_t GetAllocatingFrames() const { return m_allocatingFrames; }
+    uint64_t GetSteadyStateAllocations() const { return m_steadyStateAllocations; }
+
+private:
+    uint64_t m_warmupFrames;
+    uint64_t m_frames = 0;
+    uint64_t m_allocatingFrames = 0;
+    uint64_t m_steadyStateAllocations = 0;
+};
+
+void* TrackedAllocate(size_t size, size_t alignment, MemoryTag tag);
+void TrackedFree(void* ptr, size_t size, size_t alignment, MemoryTag tag);
+
+// Bump allocator over a single block reserved up front. Allocation never
+// falls back to the heap: running out of space returns nullptr.
+class LinearArena {
+public:
+    explicit LinearArena(size_t capacity, MemoryTag tag = MemoryTag::Scratch);
+    ~LinearArena();
+
+    LinearArena(const LinearArena&) = delete;
+    LinearArena& operator=(const LinearArena&) = delete;
+
+    void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+    void Reset() { m_offset = 0; }
+    void Rewind(size_t marker) { m_offset = marker < m_offset ? marker : m_offset; }
+
+    template <typename T>
+    T* AllocateArray(size_t count) {
+        return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+    }
+
+    size_t GetMarker() const { return m_offset; }
+    size_t GetUsed() const { return m_offset; }
+    size_t GetPeak() const { return m_peak; }
+    size_t GetCapacity() const { return m_capacity; }
+
+private:
+    unsigned char* m_buffer;
+    size_t m_capacity;
+    size_t m_offset;
+    size_t m_peak;
+    MemoryTag m_tag;
+};
+
+// Restores an arena to its current position when the scope ends.
+class ArenaScope {
+public:
+    explicit ArenaScope(LinearArena& arena) : m_arena(arena), m_marker(arena.GetMarker()) {}
+    ~ArenaScope() { m_arena.Rewind(m_marker); }
+
+    ArenaScope(const ArenaScope&) = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    LinearArena& m_arena;
+    size_t m_marker;
+};
+
+// Scratch arena owned by the calling thread, created on first use.
+LinearArena& GetThreadArena();
+
+// Fixed-size block allocator with an intrusive free list.
+class PoolAllocator {
+public:
+    PoolAllocator(size_t blockSize, size_t blockCount, MemoryTag tag = MemoryTag::Scene);
+    ~PoolAllocator();
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    void* Allocate();
+    void Free(void* block);
+    bool Owns(const void* block) const;
+
+    size_t GetBlockSize() const { return m_blockSize; }
+    size_t GetBlockCount() const { return m_blockCount; }
+    size_t GetUsedBlocks() const { return m_usedBlocks; }
+
+private:
+    unsigned char& GetState(const void* block) const;
+
+    unsigned char* m_buffer;
+    void* m_freeList;
+    size_t m_blockSize;
+    size_t m_blockCount;
+    size_t m_usedBlocks;
+    MemoryTag m_tag;
+};
+
+template <typename T>
+class ObjectPool {
+public:
+    ObjectPool(size_t capacity, MemoryTag tag = MemoryTag::Scene)
+        : m_pool(sizeof(T) < sizeof(void*) ? sizeof(void*) : sizeof(T), capacity, tag) {}
+
+    template <typename... Args>
+    T* Create(Args&&... args) {
+        void* block = m_pool.Allocate();
+        return block ? new (block) T(std::forward<Args>(args)...) : nullptr;
+    }
+
+    void Destroy(T* object) {
+        if (object) {
+            object->~T();
+            m_pool.Free(object);
+        }
+    }
+
+    size_t GetCount() const { return m_pool.GetUsedBlocks(); }
+    size_t GetCapacity() const { return m_pool.GetBlockCount(); }
+
+private:
+    static_assert(alignof(T) <= alignof(std::max_align_t), "ObjectPool does not support over-aligned types");
+    PoolAllocator m_pool;
+};
+
+// std::pmr adapter over a LinearArena. Deallocation is a no-op; memory is
+// reclaimed when the arena is reset. Exhausting the arena throws bad_alloc
+// as the memory_resource contract requires.
+class ArenaMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit ArenaMemoryResource(LinearArena& arena) : m_arena(arena) {}
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void*, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    LinearArena& m_arena;
+};
+
+// std::pmr adapter that forwards to the heap and records under a tag, for
+// long-lived containers whose footprint should show up per subsystem.
+class TrackingMemoryResource : public std::pmr::memory_resource {
+public:
+    explicit TrackingMemoryResource(MemoryTag tag) : m_tag(tag) {}
+
+private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    MemoryTag m_tag;
+};
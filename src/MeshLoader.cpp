@@ -0,0 +1,71 @@
+#include "MeshLoader.h"
+#include <fstream>
+#include <sstream>
+
+bool LoadMeshFile(const std::string& path, MeshData& data) {
+    std::ifstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    MeshData mesh;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream stream(line);
+        std::string type;
+        if (!(stream >> type) || type[0] == '#') {
+            continue;
+        }
+
+        if (type == "v") {
+            Vertex vertex;
+            if (!(stream >> vertex.position.x >> vertex.position.y >> vertex.position.z >>
+                vertex.color.x >> vertex.color.y >> vertex.color.z >> vertex.color.w)) {
+                return false;
+            }
+            mesh.vertices.push_back(vertex);
+        } else if (type == "f") {
+            uint32_t a, b, c;
+            if (!(stream >> a >> b >> c)) {
+                return false;
+            }
+            mesh.indices.push_back(a);
+            mesh.indices.push_back(b);
+            mesh.indices.push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    for (uint32_t index : mesh.indices) {
+        if (index >= mesh.vertices.size()) {
+            return false;
+        }
+    }
+
+    if (mesh.IsEmpty()) {
+        return false;
+    }
+
+    data = std::move(mesh);
+    return true;
+}
+
+bool SaveMeshFile(const std::string& path, const MeshView& mesh) {
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < mesh.vertexCount; ++i) {
+        const Vertex& vertex = mesh.vertices[i];
+        file << "v " << vertex.position.x << ' ' << vertex.position.y << ' ' << vertex.position.z << ' '
+            << vertex.color.x << ' ' << vertex.color.y << ' ' << vertex.color.z << ' ' << vertex.color.w << '\n';
+    }
+
+    for (uint32_t i = 0; i + 2 < mesh.indexCount; i += 3) {
+        file << "f " << mesh.indices[i] << ' ' << mesh.indices[i + 1] << ' ' << mesh.indices[i + 2] << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,10 @@
+#pragma once
+#include <string>
+#include "Geometry.h"
+
+// Plain-text mesh format, one record per line:
+//   v <x> <y> <z> <r> <g> <b> <a>   vertex position and colour
+//   f <i0> <i1> <i2>                triangle, zero-based vertex indices
+// Blank lines and lines starting with '#' are ignored.
+bool LoadMeshFile(const std::string& path, MeshData& data);
+bool SaveMeshFile(const std::string& path, const MeshView& mesh);
@@ -0,0 +1,132 @@
+#include "NullBackend.h"
+#include <cstring>
+
+void NullBackend::BeginFrame(uint64_t) {}
+
+void NullBackend::EndFrame() {
+    ++m_counters.frames;
+}
+
+void NullBackend::CreateBuffer(const BufferDesc& desc) {
+    if (desc.bufferId > MaxBufferId || desc.sizeInBytes > MaxBufferSize) {
+        ++m_counters.invalidCommands;
+        return;
+    }
+
+    if (desc.bufferId >= m_buffers.size()) {
+        m_buffers.resize(desc.bufferId + 1);
+    }
+
+    Buffer& buffer = m_buffers[desc.bufferId];
+    buffer.desc = desc;
+    buffer.data.assign(desc.sizeInBytes, 0);
+    buffer.created = true;
+
+    // Direct draws bind the most recently created vertex and index buffers,
+    // matching the renderer's single pooled buffer of each kind.
+    if (desc.usage == BufferUsage::Vertex) {
+        m_vertexBufferId = desc.bufferId;
+    } else if (desc.usage == BufferUsage::Index) {
+        m_indexBufferId = desc.bufferId;
+    }
+}
+
+void NullBackend::UploadBuffer(uint32_t bufferId, uint64_t offset, const void* data, uint32_t size) {
+    Buffer* buffer = FindBuffer(bufferId);
+    if (!buffer || offset > buffer->data.size() || size > buffer->data.size() - offset) {
+        ++m_counters.invalidCommands;
+        return;
+    }
+
+    std::memcpy(buffer->data.data() + offset, data, size);
+    m_counters.bytesUploaded += size;
+}
+
+void NullBackend::SetViewport(const ViewportDesc&) {}
+
+void NullBackend::SetPipeline(uint32_t pipelineId) {
+    m_pipelineId = pipelineId;
+}
+
+void NullBackend::Clear(const ClearDesc&) {}
+
+void NullBackend::DrawIndexed(const DrawIndexedArguments& arguments) {
+    Buffer* vertexBuffer = FindBuffer(m_vertexBufferId);
+    Buffer* indexBuffer = FindBuffer(m_indexBufferId);
+    uint32_t stride = vertexBuffer ? vertexBuffer->desc.stride : 0;
+    if (!m_validate || ValidateDraw(arguments, vertexBuffer, indexBuffer, 0, 0, stride)) {
+        ++m_counters.drawCalls;
+        m_counters.indices += uint64_t(arguments.indexCountPerInstance) * arguments.instanceCount;
+    }
+}
+
+void NullBackend::ExecuteIndirect(uint32_t argumentBufferId, uint32_t countBufferId, uint32_t maxCommands) {
+    Buffer* arguments = FindBuffer(argumentBufferId);
+    Buffer* count = FindBuffer(countBufferId);
+    if (!arguments || !count || count->data.size() < sizeof(uint32_t)) {
+        ++m_counters.invalidCommands;
+        return;
+    }
+
+    uint32_t drawCount;
+    std::memcpy(&drawCount, count->data.data(), sizeof(drawCount));
+    if (drawCount > maxCommands) {
+        drawCount = maxCommands;
+    }
+    if (uint64_t(drawCount) * sizeof(IndirectDrawCommand) > arguments->data.size()) {
+        ++m_counters.invalidCommands;
+        return;
+    }
+
+    // Indirect draws use the same bound buffers as direct ones; the argument
+    // records carry no buffer views.
+    Buffer* vertexBuffer = FindBuffer(m_vertexBufferId);
+    Buffer* indexBuffer = FindBuffer(m_indexBufferId);
+    uint32_t stride = vertexBuffer ? vertexBuffer->desc.stride : 0;
+
+    for (uint32_t i = 0; i < drawCount; ++i) {
+        IndirectDrawCommand command;
+        std::memcpy(&command, arguments->data.data() + i * sizeof(IndirectDrawCommand), sizeof(command));
+
+        if (!m_validate || ValidateDraw(command.draw, vertexBuffer, indexBuffer, 0, 0, stride)) {
+            ++m_counters.drawCalls;
+            m_counters.indices += uint64_t(command.draw.indexCountPerInstance) * command.draw.instanceCount;
+        }
+    }
+}
+
+NullBackend::Buffer* NullBackend::FindBuffer(uint32_t bufferId) {
+    if (bufferId >= m_buffers.size() || !m_buffers[bufferId].created) {
+        return nullptr;
+    }
+    return &m_buffers[bufferId];
+}
+
+bool NullBackend::ValidateDraw(const DrawIndexedArguments& arguments, const Buffer* vertexBuffer,
+    const Buffer* indexBuffer, uint64_t vertexOffset, uint64_t indexOffset, uint32_t stride) {
+    if (!vertexBuffer || !indexBuffer || stride == 0) {
+        ++m_counters.invalidCommands;
+        return false;
+    }
+
+    uint64_t indexCapacity = (indexBuffer->data.size() - indexOffset) / sizeof(uint32_t);
+    if (uint64_t(arguments.startIndexLocation) + arguments.indexCountPerInstance > indexCapacity) {
+        ++m_counters.invalidCommands;
+        return false;
+    }
+
+    // Every fetched vertex must lie inside the bound vertex buffer.
+    uint64_t vertexCapacity = (vertexBuffer->data.size() - vertexOffset) / stride;
+    const uint8_t* indices = indexBuffer->data.data() + indexOffset;
+    for (uint32_t i = 0; i < arguments.indexCountPerInstance; ++i) {
+        uint32_t index;
+        std::memcpy(&index, indices + (uint64_t(arguments.startIndexLocation) + i) * sizeof(uint32_t), sizeof(index));
+        int64_t vertex = int64_t(index) + arguments.baseVertexLocation;
+        if (vertex < 0 || uint64_t(vertex) >= vertexCapacity) {
+            ++m_counters.invalidCommands;
+            return false;
+        }
+    }
+
+    return true;
+}
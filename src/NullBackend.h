@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "CommandBackend.h"
+
+// Backend that executes a command stream entirely on the CPU without a GPU:
+// buffers are kept in memory and indirect draws are decoded from them and
+// validated against the bound vertex and index buffers. Used to replay captures on
+// machines without D3D12 and to time the submission path in isolation.
+class NullBackend : public ICommandBackend {
+public:
+    // Captures come from untrusted files, so buffer ids and sizes beyond
+    // these are rejected as invalid commands instead of being allocated.
+    static constexpr uint32_t MaxBufferId = 1024;
+    static constexpr uint64_t MaxBufferSize = 256ull * 1024 * 1024;
+
+    struct Counters {
+        uint64_t frames;
+        uint64_t drawCalls;
+        uint64_t indices;
+        uint64_t bytesUploaded;
+        uint64_t invalidCommands;
+    };
+
+    void BeginFrame(uint64_t frameIndex) override;
+    void EndFrame() override;
+    void CreateBuffer(const BufferDesc& desc) override;
+    void UploadBuffer(uint32_t bufferId, uint64_t offset, const void* data, uint32_t size) override;
+    void SetViewport(const ViewportDesc& viewport) override;
+    void SetPipeline(uint32_t pipelineId) override;
+    void Clear(const ClearDesc& clear) override;
+    void DrawIndexed(const DrawIndexedArguments& arguments) override;
+    void ExecuteIndirect(uint32_t argumentBufferId, uint32_t countBufferId, uint32_t maxCommands) override;
+
+    // With validation off draws are only counted, like a driver that trusts
+    // its input; this isolates the CPU cost of recording and submission.
+    void SetValidation(bool enabled) { m_validate = enabled; }
+
+    const Counters& GetCounters() const { return m_counters; }
+    void ResetCounters() { m_counters = {}; }
+
+private:
+    struct Buffer {
+        BufferDesc desc = {};
+        std::vector<uint8_t> data;
+        bool created = false;
+    };
+
+    Buffer* FindBuffer(uint32_t bufferId);
+    bool ValidateDraw(const DrawIndexedArguments& arguments, const Buffer* vertexBuffer,
+        const Buffer* indexBuffer, uint64_t vertexOffset, uint64_t indexOffset, uint32_t stride);
+
+    std::vector<Buffer> m_buffers;
+    uint32_t m_vertexBufferId = UINT32_MAX;
+    uint32_t m_indexBufferId = UINT32_MAX;
+    uint32_t m_pipelineId = 0;
+    Counters m_counters = {};
+    bool m_validate = true;
+};
@@ -0,0 +1,165 @@
+#include "Parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+    std::atomic<uint32_t> g_workerCount{ 0 };
+
+    struct ParallelJob {
+        const std::function<void(uint32_t, uint32_t)>* body;
+        uint32_t count;
+        uint32_t chunkSize;
+        uint32_t chunkCount;
+        std::atomic<uint32_t> nextChunk{ 0 };
+        std::atomic<bool> failed{ false };
+        std::mutex errorMutex;
+        std::exception_ptr error;
+        // Pool threads currently running chunks; guarded by the pool mutex.
+        uint32_t workers = 0;
+    };
+
+    // Claims and runs chunks until none are left. A throwing chunk stops
+    // further claims; the first exception is kept for the caller.
+    void RunChunks(ParallelJob& job) {
+        while (!job.failed.load(std::memory_order_relaxed)) {
+            uint32_t chunk = job.nextChunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= job.chunkCount) {
+                return;
+            }
+
+            uint32_t begin = chunk * job.chunkSize;
+            uint32_t end = std::min(job.count, begin + job.chunkSize);
+            try {
+                (*job.body)(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.errorMutex);
+                if (!job.error) {
+                    job.error = std::current_exception();
+                }
+                job.failed.store(true, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Threads are started on first use and live until exit, so a call costs
+    // a wake-up rather than a thread create and join. The caller always
+    // works on its own job, which keeps nested ParallelFor calls from
+    // waiting on a pool that is busy with their parent.
+    class WorkerPool {
+    public:
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stopping = true;
+            }
+            m_wake.notify_all();
+            for (auto& thread : m_threads) {
+                thread.join();
+            }
+        }
+
+        void Run(ParallelJob& job) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                while (m_threads.size() < job.chunkCount - 1) {
+                    m_threads.emplace_back([this]() { WorkerLoop(); });
+                }
+                m_jobs.push_back(&job);
+            }
+            m_wake.notify_all();
+
+            RunChunks(job);
+
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                RemoveJob(job);
+                m_finished.wait(lock, [&job]() { return job.workers == 0; });
+            }
+
+            if (job.error) {
+                std::rethrow_exception(job.error);
+            }
+        }
+
+    private:
+        void WorkerLoop() {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            for (;;) {
+                m_wake.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+                if (m_stopping) {
+                    return;
+                }
+
+                ParallelJob& job = *m_jobs.front();
+                ++job.workers;
+                lock.unlock();
+                RunChunks(job);
+                lock.lock();
+
+                // Every chunk is claimed, so nobody else needs to pick it up.
+                RemoveJob(job);
+                if (--job.workers == 0) {
+                    m_finished.notify_all();
+                }
+            }
+        }
+
+        void RemoveJob(ParallelJob& job) {
+            auto it = std::find(m_jobs.begin(), m_jobs.end(), &job);
+            if (it != m_jobs.end()) {
+                m_jobs.erase(it);
+            }
+        }
+
+        std::mutex m_mutex;
+        std::condition_variable m_wake;
+        std::condition_variable m_finished;
+        std::deque<ParallelJob*> m_jobs;
+        std::vector<std::thread> m_threads;
+        bool m_stopping = false;
+    };
+
+    WorkerPool& GetWorkerPool() {
+        static WorkerPool pool;
+        return pool;
+    }
+}
+
+uint32_t GetWorkerCount() {
+    uint32_t count = g_workerCount.load(std::memory_order_relaxed);
+    if (count == 0) {
+        count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    return count;
+}
+
+void SetWorkerCount(uint32_t count) {
+    g_workerCount.store(count, std::memory_order_relaxed);
+}
+
+void ParallelFor(uint32_t count, uint32_t grainSize,
+    const std::function<void(uint32_t begin, uint32_t end)>& body) {
+    if (count == 0) {
+        return;
+    }
+
+    grainSize = std::max(1u, grainSize);
+    uint32_t chunkCount = std::min(GetWorkerCount(), (count + grainSize - 1) / grainSize);
+    if (chunkCount <= 1) {
+        body(0, count);
+        return;
+    }
+
+    ParallelJob job;
+    job.body = &body;
+    job.count = count;
+    job.chunkSize = (count + chunkCount - 1) / chunkCount;
+    job.chunkCount = (count + job.chunkSize - 1) / job.chunkSize;
+    GetWorkerPool().Run(job);
+}
@@ -0,0 +1,14 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+
+// Splits [0, count) into contiguous chunks of at least grainSize items and
+// runs body(begin, end) for each chunk, using the calling thread plus up to
+// GetWorkerCount() - 1 threads from a persistent pool. Small ranges run
+// inline. If body throws, chunks not yet started are skipped and the first
+// exception is rethrown on the calling thread once running chunks finish.
+void ParallelFor(uint32_t count, uint32_t grainSize,
+    const std::function<void(uint32_t begin, uint32_t end)>& body);
+
+uint32_t GetWorkerCount();
+void SetWorkerCount(uint32_t count);
@@ -0,0 +1,76 @@
+#include "RangeAllocator.h"
+#include <iterator>
+
+RangeAllocator::RangeAllocator(uint32_t capacity) : m_capacity(0), m_used(0), m_highWaterMark(0) {
+    Reset(capacity);
+}
+
+void RangeAllocator::Reset(uint32_t capacity) {
+    m_freeRanges.clear();
+    m_capacity = capacity;
+    m_used = 0;
+    m_highWaterMark = 0;
+    if (capacity > 0) {
+        m_freeRanges[0] = capacity;
+    }
+}
+
+bool RangeAllocator::Allocate(uint32_t size, uint32_t& offset) {
+    if (size == 0) {
+        return false;
+    }
+
+    for (auto it = m_freeRanges.begin(); it != m_freeRanges.end(); ++it) {
+        if (it->second < size) {
+            continue;
+        }
+
+        offset = it->first;
+        uint32_t remaining = it->second - size;
+        m_freeRanges.erase(it);
+        if (remaining > 0) {
+            m_freeRanges[offset + size] = remaining;
+        }
+        m_used += size;
+        if (offset + size > m_highWaterMark) {
+            m_highWaterMark = offset + size;
+        }
+        return true;
+    }
+
+    return false;
+}
+
+void RangeAllocator::Free(uint32_t offset, uint32_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    m_used -= size;
+
+    auto next = m_freeRanges.lower_bound(offset);
+    if (next != m_freeRanges.end() && offset + size == next->first) {
+        size += next->second;
+        next = m_freeRanges.erase(next);
+    }
+
+    if (next != m_freeRanges.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == offset) {
+            prev->second += size;
+            return;
+        }
+    }
+
+    m_freeRanges[offset] = size;
+}
+
+uint32_t RangeAllocator::GetLargestFreeRange() const {
+    uint32_t largest = 0;
+    for (const auto& range : m_freeRanges) {
+        if (range.second > largest) {
+            largest = range.second;
+        }
+    }
+    return largest;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <map>
+
+// First-fit sub-allocator over [0, capacity) used to place meshes inside the
+// pooled vertex and index buffers. Freed ranges are coalesced with their
+// neighbours.
+class RangeAllocator {
+public:
+    explicit RangeAllocator(uint32_t capacity = 0);
+
+    void Reset(uint32_t capacity);
+    bool Allocate(uint32_t size, uint32_t& offset);
+    void Free(uint32_t offset, uint32_t size);
+
+    uint32_t GetCapacity() const { return m_capacity; }
+    uint32_t GetUsed() const { return m_used; }
+    uint32_t GetLargestFreeRange() const;
+    // One past the highest element ever handed out since the last Reset.
+    uint32_t GetHighWaterMark() const { return m_highWaterMark; }
+
+private:
+    std::map<uint32_t, uint32_t> m_freeRanges;
+    uint32_t m_capacity;
+    uint32_t m_used;
+    uint32_t m_highWaterMark;
+};
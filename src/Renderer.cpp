@@ -1,11 +1,46 @@
 #include "Renderer.h"
+#include "MeshLoader.h"
 #include <d3dcompiler.h>
 #include <stdexcept>
 #include <iostream>
+#include <chrono>
+#include <algorithm>
+
+#ifndef ENGINE_ASSET_DIR
+#define ENGINE_ASSET_DIR "assets"
+#endif
+
+namespace {
+    const char* const VertexShaderTarget = "shader:BasicVS";
+    const char* const PixelShaderTarget = "shader:BasicPS";
+    const char* const PipelineTarget = "pipeline:Basic";
+    const char* const UpscaleVertexShaderTarget = "shader:UpscaleVS";
+    const char* const UpscalePixelShaderTarget = "shader:UpscalePS";
+    const char* const UpscalePipelineTarget = "pipeline:Upscale";
+
+    const float SceneClearColor[] = { 0.2f, 0.2f, 0.3f, 1.0f };
+
+    template <typename T>
+    bool IsReady(const std::future<T>& future) {
+        return future.valid() &&
+            future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+}
+
+static_assert(sizeof(DrawIndexedArguments) == sizeof(D3D12_DRAW_INDEXED_ARGUMENTS), "DrawIndexedArguments layout mismatch");
 
 Renderer::Renderer()
-    : m_width(0), m_height(0), m_currentBackBufferIndex(0),
-    m_fenceValue(1), m_fenceEvent(nullptr) {}
+    : m_mappedArguments(nullptr), m_mappedCount(nullptr), m_useIndirectDraw(true),
+    m_frameArena(FrameArenaCapacity, MemoryTag::Renderer),
+    m_residency(m_geometryPool, DefaultGeometryBudget), m_frameIndex(0),
+    m_assetDirectory(NormalizePath(ENGINE_ASSET_DIR)),
+    m_vertexShaderDirty(false), m_pixelShaderDirty(false),
+    m_upscaleVertexShaderDirty(false), m_upscalePixelShaderDirty(false), m_pipelineId(1),
+    m_captureFramesRemaining(0), m_captureSnapshotPending(false),
+    m_width(0), m_height(0), m_currentBackBufferIndex(0),
+    m_fenceValue(1), m_fenceEvent(nullptr),
+    m_timestampFrequency(0), m_dynamicResolution(true), m_renderScale(1.0f),
+    m_renderWidth(0), m_renderHeight(0) {}
 
 Renderer::~Renderer() {
     Shutdown();
@@ -20,13 +55,18 @@ bool Renderer::Initialize(HWND hwnd, int width, int height) {
     }
 
     if(!CreateCommandObjects() || !CreateSwapChain(hwnd) ||
-        !CreateRenderTargets() || !CreateDepthBuffer() ||
-        !CreateRootSignature() || !CreatePipelineState()) {
+        !CreateRenderTargets() || !CreateDepthBuffer() || !CreateSceneTarget() ||
+        !CreateRootSignature() || !CreatePipelineState() || !CreateUpscalePipeline() ||
+        !CreateIndirectResources() || !CreateTimestampQueries()) {
+        return false;
+    }
+
+    if (!CreateMeshes()) {
         return false;
     }
 
-    CreateMeshes();
     UpdateViewport();
+    InitializeHotReload();
 
     return true;
 }
@@ -118,12 +158,14 @@ bool Renderer::CreateSwapChain(HWND hwnd) {
 }
 
 bool Renderer::CreateRenderTargets() {
-    D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
-    rtvHeapDesc.NumDescriptors = 2;
-    rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
-    
-    if (FAILED(m_device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_rtvHeap)))) {
-        return false;
+    if (!m_rtvHeap) {
+        D3D12_DESCRIPTOR_HEAP_DESC rtvHeapDesc = {};
+        rtvHeapDesc.NumDescriptors = SceneRtvIndex + 1;
+        rtvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_RTV;
+
+        if (FAILED(m_device->CreateDescriptorHeap(&rtvHeapDesc, IID_PPV_ARGS(&m_rtvHeap)))) {
+            return false;
+        }
     }
     
     UINT rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
@@ -141,12 +183,14 @@ bool Renderer::CreateRenderTargets() {
 }
 
 bool Renderer::CreateDepthBuffer() {
-    D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc = {};
-    dsvHeapDesc.NumDescriptors = 1;
-    dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
-    
-    if (FAILED(m_device->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(&m_dsvHeap)))) {
-        return false;
+    if (!m_dsvHeap) {
+        D3D12_DESCRIPTOR_HEAP_DESC dsvHeapDesc = {};
+        dsvHeapDesc.NumDescriptors = 1;
+        dsvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_DSV;
+
+        if (FAILED(m_device->CreateDescriptorHeap(&dsvHeapDesc, IID_PPV_ARGS(&m_dsvHeap)))) {
+            return false;
+        }
     }
     
     D3D12_RESOURCE_DESC depthDesc = {};
@@ -181,6 +225,63 @@ bool Renderer::CreateDepthBuffer() {
     return true;
 }
 
+bool Renderer::CreateSceneTarget() {
+    if (!m_srvHeap) {
+        D3D12_DESCRIPTOR_HEAP_DESC srvHeapDesc = {};
+        srvHeapDesc.NumDescriptors = 1;
+        srvHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+        srvHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+        if (FAILED(m_device->CreateDescriptorHeap(&srvHeapDesc, IID_PPV_ARGS(&m_srvHeap)))) {
+            return false;
+        }
+    }
+
+    // Allocated at output size so scale changes only move the viewport and
+    // never reallocate; the depth buffer is sized the same way.
+    D3D12_RESOURCE_DESC sceneDesc = {};
+    sceneDesc.Dimension = D3D12_RESOURCE_DIMENSION_TEXTURE2D;
+    sceneDesc.Width = m_width;
+    sceneDesc.Height = m_height;
+    sceneDesc.DepthOrArraySize = 1;
+    sceneDesc.MipLevels = 1;
+    sceneDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    sceneDesc.SampleDesc.Count = 1;
+    sceneDesc.Flags = D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET;
+
+    D3D12_CLEAR_VALUE clearValue = {};
+    clearValue.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    for (int i = 0; i < 4; ++i) {
+        clearValue.Color[i] = SceneClearColor[i];
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_DEFAULT;
+    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+    if (FAILED(m_device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE,
+        &sceneDesc, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, &clearValue,
+        IID_PPV_ARGS(&m_sceneTarget)))) {
+        return false;
+    }
+
+    UINT rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
+    rtvHandle.ptr += SceneRtvIndex * rtvDescriptorSize;
+    m_device->CreateRenderTargetView(m_sceneTarget.Get(), nullptr, rtvHandle);
+
+    D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
+    srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+    srvDesc.Texture2D.MipLevels = 1;
+    m_device->CreateShaderResourceView(m_sceneTarget.Get(), &srvDesc,
+        m_srvHeap->GetCPUDescriptorHandleForHeapStart());
+
+    return true;
+}
+
 bool Renderer::CreateRootSignature() {
     D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
     rootSigDesc.NumParameters = 0;
@@ -209,60 +310,29 @@ bool Renderer::CreateRootSignature() {
 }
 
 bool Renderer::CreatePipelineState() {
-    const char* shaderCode = R"(
-        cbuffer TransformBuffer : register(b0) {
-            float4x4 viewProj;
-        };
-        
-        struct VS_INPUT {
-            float3 pos : POSITION;
-            float4 color : COLOR;
-        };
-        
-        struct PS_INPUT {
-            float4 pos : SV_POSITION;
-            float4 color : COLOR;
-        };
-        
-        PS_INPUT main(VS_INPUT input) {
-            PS_INPUT output;
-            output.pos = mul(float4(input.pos, 1.0f), viewProj);
-            output.color = input.color;
-            return output;
-        }
-    )";
-    
-    ComPtr<ID3DBlob> vsBlob;
-    ComPtr<ID3DBlob> error;
-    
-    if (FAILED(D3DCompile(shaderCode, strlen(shaderCode), nullptr, nullptr, nullptr,
-        "main", "vs_5_0", 0, 0, &vsBlob, &error))) {
-        if (error) {
-            std::cerr << "VS Compile error: " << (char*)error->GetBufferPointer() << "\n";
-        }
+    std::string shaderDirectory = m_assetDirectory + "/shaders";
+    m_vertexShaderDesc = { "BasicVS", "BasicVS.hlsl", "main", "vs_5_0", {} };
+    m_pixelShaderDesc = { "BasicPS", "BasicPS.hlsl", "main", "ps_5_0", {} };
+
+    std::vector<std::string> vertexDependencies;
+    if (!CompileShaderFile(shaderDirectory, m_vertexShaderDesc, m_vertexShader, vertexDependencies)) {
         return false;
     }
-    
-    const char* psCode = R"(
-        struct PS_INPUT {
-            float4 pos : SV_POSITION;
-            float4 color : COLOR;
-        };
-        
-        float4 main(PS_INPUT input) : SV_TARGET {
-            return input.color;
-        }
-    )";
-    
-    ComPtr<ID3DBlob> psBlob;
-    if (FAILED(D3DCompile(psCode, strlen(psCode), nullptr, nullptr, nullptr,
-        "main", "ps_5_0", 0, 0, &psBlob, &error))) {
-        if (error) {
-            std::cerr << "PS Compile error: " << (char*)error->GetBufferPointer() << "\n";
-        }
+
+    std::vector<std::string> pixelDependencies;
+    if (!CompileShaderFile(shaderDirectory, m_pixelShaderDesc, m_pixelShader, pixelDependencies)) {
         return false;
     }
-    
+
+    m_dependencies.SetDependencies(VertexShaderTarget, vertexDependencies);
+    m_dependencies.SetDependencies(PixelShaderTarget, pixelDependencies);
+    m_dependencies.SetDependencies(PipelineTarget, { VertexShaderTarget, PixelShaderTarget });
+
+    return BuildPipelineState(m_vertexShader.Get(), m_pixelShader.Get(), m_pipelineState);
+}
+
+bool Renderer::BuildPipelineState(ID3DBlob* vertexShader, ID3DBlob* pixelShader,
+    ComPtr<ID3D12PipelineState>& pipelineState) const {
     D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
         { "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
         { "COLOR", 0, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, 12, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
@@ -270,10 +340,10 @@ bool Renderer::CreatePipelineState() {
     
     D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
     psoDesc.pRootSignature = m_rootSignature.Get();
-    psoDesc.VS.pShaderBytecode = vsBlob->GetBufferPointer();
-    psoDesc.VS.BytecodeLength = vsBlob->GetBufferSize();
-    psoDesc.PS.pShaderBytecode = psBlob->GetBufferPointer();
-    psoDesc.PS.BytecodeLength = psBlob->GetBufferSize();
+    psoDesc.VS.pShaderBytecode = vertexShader->GetBufferPointer();
+    psoDesc.VS.BytecodeLength = vertexShader->GetBufferSize();
+    psoDesc.PS.pShaderBytecode = pixelShader->GetBufferPointer();
+    psoDesc.PS.BytecodeLength = pixelShader->GetBufferSize();
     psoDesc.BlendState.AlphaToCoverageEnable = FALSE;
     psoDesc.BlendState.IndependentBlendEnable = FALSE;
     psoDesc.BlendState.RenderTarget[0].BlendEnable = FALSE;
@@ -302,74 +372,653 @@ bool Renderer::CreatePipelineState() {
     psoDesc.SampleDesc.Count = 1;
     psoDesc.SampleDesc.Quality = 0;
     
-    if (FAILED(m_device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&m_pipelineState)))) {
+    if (FAILED(m_device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState)))) {
         return false;
     }
     
     return true;
 }
 
-void Renderer::CreateMeshes() {
-    Mesh cube = Mesh::CreateCube(1.0f);
+bool Renderer::CreateUpscalePipeline() {
+    D3D12_DESCRIPTOR_RANGE srvRange = {};
+    srvRange.RangeType = D3D12_DESCRIPTOR_RANGE_TYPE_SRV;
+    srvRange.NumDescriptors = 1;
+    srvRange.BaseShaderRegister = 0;
+    srvRange.OffsetInDescriptorsFromTableStart = 0;
+
+    D3D12_ROOT_PARAMETER rootParameters[2] = {};
+    rootParameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+    rootParameters[0].DescriptorTable.NumDescriptorRanges = 1;
+    rootParameters[0].DescriptorTable.pDescriptorRanges = &srvRange;
+    rootParameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+    rootParameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+    rootParameters[1].Constants.ShaderRegister = 0;
+    rootParameters[1].Constants.Num32BitValues = 4;
+    rootParameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+    D3D12_STATIC_SAMPLER_DESC sampler = {};
+    sampler.Filter = D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+    sampler.AddressU = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+    sampler.AddressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+    sampler.AddressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+    sampler.ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+    sampler.MaxLOD = D3D12_FLOAT32_MAX;
+    sampler.ShaderRegister = 0;
+    sampler.ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+
+    D3D12_ROOT_SIGNATURE_DESC rootSigDesc = {};
+    rootSigDesc.NumParameters = 2;
+    rootSigDesc.pParameters = rootParameters;
+    rootSigDesc.NumStaticSamplers = 1;
+    rootSigDesc.pStaticSamplers = &sampler;
+    rootSigDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+    ComPtr<ID3DBlob> signature;
+    ComPtr<ID3DBlob> error;
+
+    if (FAILED(D3D12SerializeRootSignature(&rootSigDesc, D3D_ROOT_SIGNATURE_VERSION_1,
+        &signature, &error))) {
+        if (error) {
+            std::cerr << "Root signature error: " << (char*)error->GetBufferPointer() << "\n";
+        }
+        return false;
+    }
+
+    if (FAILED(m_device->CreateRootSignature(0, signature->GetBufferPointer(),
+        signature->GetBufferSize(), IID_PPV_ARGS(&m_upscaleRootSignature)))) {
+        return false;
+    }
+
+    std::string shaderDirectory = m_assetDirectory + "/shaders";
+    m_upscaleVertexShaderDesc = { "UpscaleVS", "UpscaleVS.hlsl", "main", "vs_5_0", {} };
+    m_upscalePixelShaderDesc = { "UpscalePS", "UpscalePS.hlsl", "main", "ps_5_0", {} };
+
+    std::vector<std::string> vertexDependencies;
+    if (!CompileShaderFile(shaderDirectory, m_upscaleVertexShaderDesc, m_upscaleVertexShader, vertexDependencies)) {
+        return false;
+    }
+
+    std::vector<std::string> pixelDependencies;
+    if (!CompileShaderFile(shaderDirectory, m_upscalePixelShaderDesc, m_upscalePixelShader, pixelDependencies)) {
+        return false;
+    }
+
+    m_dependencies.SetDependencies(UpscaleVertexShaderTarget, vertexDependencies);
+    m_dependencies.SetDependencies(UpscalePixelShaderTarget, pixelDependencies);
+    m_dependencies.SetDependencies(UpscalePipelineTarget, { UpscaleVertexShaderTarget, UpscalePixelShaderTarget });
+
+    return BuildUpscalePipelineState(m_upscaleVertexShader.Get(), m_upscalePixelShader.Get(),
+        m_upscalePipelineState);
+}
+
+bool Renderer::BuildUpscalePipelineState(ID3DBlob* vertexShader, ID3DBlob* pixelShader,
+    ComPtr<ID3D12PipelineState>& pipelineState) const {
+    D3D12_GRAPHICS_PIPELINE_STATE_DESC psoDesc = {};
+    psoDesc.pRootSignature = m_upscaleRootSignature.Get();
+    psoDesc.VS.pShaderBytecode = vertexShader->GetBufferPointer();
+    psoDesc.VS.BytecodeLength = vertexShader->GetBufferSize();
+    psoDesc.PS.pShaderBytecode = pixelShader->GetBufferPointer();
+    psoDesc.PS.BytecodeLength = pixelShader->GetBufferSize();
+    psoDesc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+    psoDesc.SampleMask = UINT_MAX;
+    psoDesc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+    psoDesc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+    psoDesc.RasterizerState.DepthClipEnable = TRUE;
+    psoDesc.DepthStencilState.DepthEnable = FALSE;
+    psoDesc.IBStripCutValue = D3D12_INDEX_BUFFER_STRIP_CUT_VALUE_DISABLED;
+    psoDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+    psoDesc.NumRenderTargets = 1;
+    psoDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+    psoDesc.DSVFormat = DXGI_FORMAT_UNKNOWN;
+    psoDesc.SampleDesc.Count = 1;
+
+    if (FAILED(m_device->CreateGraphicsPipelineState(&psoDesc, IID_PPV_ARGS(&pipelineState)))) {
+        return false;
+    }
+
+    return true;
+}
+
+bool Renderer::CreateIndirectResources() {
+    // All meshes share the pooled vertex and index buffers, bound once in
+    // SubmitIndirect, so each record only needs the draw arguments.
+    D3D12_INDIRECT_ARGUMENT_DESC argumentDesc = {};
+    argumentDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+    D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+    signatureDesc.ByteStride = sizeof(IndirectDrawCommand);
+    signatureDesc.NumArgumentDescs = 1;
+    signatureDesc.pArgumentDescs = &argumentDesc;
+
+    // No root arguments change per draw, so the signature needs no root signature.
+    if (FAILED(m_device->CreateCommandSignature(&signatureDesc, nullptr,
+        IID_PPV_ARGS(&m_commandSignature)))) {
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_UPLOAD;
+    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = sizeof(IndirectDrawCommand) * MaxIndirectDraws;
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    if (FAILED(m_device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE,
+        &bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+        IID_PPV_ARGS(&m_argumentBuffer)))) {
+        return false;
+    }
+
+    bufferDesc.Width = sizeof(uint32_t);
+    if (FAILED(m_device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE,
+        &bufferDesc, D3D12_RESOURCE_STATE_GENERIC_READ, nullptr,
+        IID_PPV_ARGS(&m_countBuffer)))) {
+        return false;
+    }
+
+    // Both buffers stay mapped; EndFrame waits on the fence, so the GPU is
+    // never reading them while Render rewrites their contents.
+    D3D12_RANGE readRange = { 0, 0 };
+    if (FAILED(m_argumentBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_mappedArguments))) ||
+        FAILED(m_countBuffer->Map(0, &readRange, reinterpret_cast<void**>(&m_mappedCount)))) {
+        return false;
+    }
+
+    return true;
+}
+
+bool Renderer::CreateTimestampQueries() {
+    D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+    queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+    queryHeapDesc.Count = 2;
+
+    if (FAILED(m_device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&m_timestampHeap)))) {
+        return false;
+    }
+
+    D3D12_HEAP_PROPERTIES heapProps = {};
+    heapProps.Type = D3D12_HEAP_TYPE_READBACK;
+    heapProps.CPUPageProperty = D3D12_CPU_PAGE_PROPERTY_UNKNOWN;
+    heapProps.MemoryPoolPreference = D3D12_MEMORY_POOL_UNKNOWN;
+
+    D3D12_RESOURCE_DESC bufferDesc = {};
+    bufferDesc.Dimension = D3D12_RESOURCE_DIMENSION_BUFFER;
+    bufferDesc.Width = 2 * sizeof(UINT64);
+    bufferDesc.Height = 1;
+    bufferDesc.DepthOrArraySize = 1;
+    bufferDesc.MipLevels = 1;
+    bufferDesc.Format = DXGI_FORMAT_UNKNOWN;
+    bufferDesc.SampleDesc.Count = 1;
+    bufferDesc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
+
+    if (FAILED(m_device->CreateCommittedResource(&heapProps, D3D12_HEAP_FLAG_NONE,
+        &bufferDesc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr,
+        IID_PPV_ARGS(&m_timestampReadback)))) {
+        return false;
+    }
+
+    // Without a frequency the controller never runs and the scale stays at 1.
+    if (FAILED(m_commandQueue->GetTimestampFrequency(&m_timestampFrequency))) {
+        m_timestampFrequency = 0;
+    }
+
+    return true;
+}
+
+bool Renderer::CreateMeshes() {
+    if (!m_geometryPool.Initialize(m_device.Get(), MaxPoolVertices, MaxPoolIndices)) {
+        return false;
+    }
+
+    std::string cubePath = NormalizePath(m_assetDirectory + "/meshes/cube.mesh");
+    MeshHandle cubeHandle = InvalidMeshHandle;
+    MeshData cubeData;
+    if (LoadMeshFile(cubePath, cubeData)) {
+        cubeHandle = m_residency.Register(std::move(cubeData),
+            [cubePath](MeshData& data) { return LoadMeshFile(cubePath, data); });
+        m_residency.ReleaseCpuData(cubeHandle);
+        m_meshAssets.push_back({ "mesh:cube", cubePath, cubeHandle });
+        m_dependencies.SetDependencies("mesh:cube", { cubePath });
+    } else {
+        std::cerr << "Failed to load " << cubePath << ", using built-in cube\n";
+        cubeHandle = m_residency.RegisterStatic(UnitCube.GetView());
+    }
+
+    if (cubeHandle == InvalidMeshHandle) {
+        return false;
+    }
+
+    Mesh cube;
+    cube.handle = cubeHandle;
     cube.position = XMFLOAT3(0.0f, 0.0f, 3.0f);
     m_meshes.push_back(cube);
+
+    return true;
+}
+
+void Renderer::InitializeHotReload() {
+    // Hot reload is a development convenience; without a watcher the
+    // renderer simply keeps the assets it loaded at startup.
+    if (!m_fileWatcher.Watch(m_assetDirectory + "/shaders") ||
+        !m_fileWatcher.Watch(m_assetDirectory + "/meshes")) {
+        std::cerr << "Asset hot reload disabled for " << m_assetDirectory << "\n";
+    }
+}
+
+void Renderer::UpdateHotReload() {
+    // Called at the frame boundary: EndFrame waited on the fence, so the GPU
+    // no longer references the pipeline state or mesh ranges being replaced.
+    if (IsReady(m_pendingPipeline)) {
+        PipelineBuild build = m_pendingPipeline.get();
+        if (build.vertexShader.compiled) {
+            m_vertexShader = build.vertexShader.bytecode;
+            m_dependencies.SetDependencies(VertexShaderTarget, build.vertexShader.dependencies);
+        }
+        if (build.pixelShader.compiled) {
+            m_pixelShader = build.pixelShader.bytecode;
+            m_dependencies.SetDependencies(PixelShaderTarget, build.pixelShader.dependencies);
+        }
+        if (build.pipelineState) {
+            m_pipelineState = build.pipelineState;
+            ++m_pipelineId;
+        }
+    }
+
+    if (IsReady(m_pendingUpscalePipeline)) {
+        PipelineBuild build = m_pendingUpscalePipeline.get();
+        if (build.vertexShader.compiled) {
+            m_upscaleVertexShader = build.vertexShader.bytecode;
+            m_dependencies.SetDependencies(UpscaleVertexShaderTarget, build.vertexShader.dependencies);
+        }
+        if (build.pixelShader.compiled) {
+            m_upscalePixelShader = build.pixelShader.bytecode;
+            m_dependencies.SetDependencies(UpscalePixelShaderTarget, build.pixelShader.dependencies);
+        }
+        if (build.pipelineState) {
+            m_upscalePipelineState = build.pipelineState;
+        }
+    }
+
+    for (size_t i = 0; i < m_pendingMeshes.size();) {
+        if (!IsReady(m_pendingMeshes[i])) {
+            ++i;
+            continue;
+        }
+
+        MeshLoadResult result = m_pendingMeshes[i].get();
+        if (result.loaded && m_residency.Replace(result.handle, std::move(result.data))) {
+            m_residency.ReleaseCpuData(result.handle);
+        }
+        m_pendingMeshes.erase(m_pendingMeshes.begin() + i);
+    }
+
+    std::vector<std::string> changedFiles;
+    m_fileWatcher.Poll(changedFiles);
+    if (!changedFiles.empty()) {
+        for (const auto& target : m_dependencies.GetAffectedTargets(changedFiles)) {
+            if (target == VertexShaderTarget) {
+                m_vertexShaderDirty = true;
+            } else if (target == PixelShaderTarget) {
+                m_pixelShaderDirty = true;
+            } else if (target == UpscaleVertexShaderTarget) {
+                m_upscaleVertexShaderDirty = true;
+            } else if (target == UpscalePixelShaderTarget) {
+                m_upscalePixelShaderDirty = true;
+            }
+
+            for (const auto& asset : m_meshAssets) {
+                if (asset.target != target) {
+                    continue;
+                }
+                MeshHandle handle = asset.handle;
+                std::string path = asset.path;
+                m_pendingMeshes.push_back(std::async(std::launch::async, [handle, path]() {
+                    MeshLoadResult result;
+                    result.handle = handle;
+                    result.loaded = LoadMeshFile(path, result.data);
+                    return result;
+                }));
+            }
+        }
+    }
+
+    // Only one build per pipeline runs at a time; changes that arrive
+    // meanwhile stay flagged and start the next build once this one has been
+    // applied.
+    if ((m_vertexShaderDirty || m_pixelShaderDirty) && !m_pendingPipeline.valid()) {
+        m_pendingPipeline = StartPipelineBuild(m_vertexShaderDesc, m_pixelShaderDesc,
+            m_vertexShaderDirty ? nullptr : m_vertexShader, m_pixelShaderDirty ? nullptr : m_pixelShader,
+            &Renderer::BuildPipelineState);
+        m_vertexShaderDirty = false;
+        m_pixelShaderDirty = false;
+    }
+
+    if ((m_upscaleVertexShaderDirty || m_upscalePixelShaderDirty) && !m_pendingUpscalePipeline.valid()) {
+        m_pendingUpscalePipeline = StartPipelineBuild(m_upscaleVertexShaderDesc, m_upscalePixelShaderDesc,
+            m_upscaleVertexShaderDirty ? nullptr : m_upscaleVertexShader,
+            m_upscalePixelShaderDirty ? nullptr : m_upscalePixelShader,
+            &Renderer::BuildUpscalePipelineState);
+        m_upscaleVertexShaderDirty = false;
+        m_upscalePixelShaderDirty = false;
+    }
+}
+
+std::future<PipelineBuild> Renderer::StartPipelineBuild(const ShaderDesc& vertexDesc, const ShaderDesc& pixelDesc,
+    ComPtr<ID3DBlob> vertexShader, ComPtr<ID3DBlob> pixelShader, PipelineBuilder builder) {
+    std::string shaderDirectory = m_assetDirectory + "/shaders";
+    return std::async(std::launch::async,
+        [this, shaderDirectory, vertexDesc, pixelDesc, vertexShader, pixelShader, builder]() {
+        PipelineBuild build;
+        build.vertexShader.bytecode = vertexShader;
+        build.pixelShader.bytecode = pixelShader;
+
+        if (!vertexShader) {
+            build.vertexShader.compiled = CompileShaderFile(shaderDirectory, vertexDesc,
+                build.vertexShader.bytecode, build.vertexShader.dependencies);
+        }
+        if (!pixelShader) {
+            build.pixelShader.compiled = CompileShaderFile(shaderDirectory, pixelDesc,
+                build.pixelShader.bytecode, build.pixelShader.dependencies);
+        }
+
+        if (build.vertexShader.bytecode && build.pixelShader.bytecode) {
+            (this->*builder)(build.vertexShader.bytecode.Get(), build.pixelShader.bytecode.Get(),
+                build.pipelineState);
+        }
+        return build;
+    });
 }
 
 void Renderer::UpdateViewport() {
+    m_renderWidth = (std::max)(1, static_cast<int>(m_width * m_renderScale + 0.5f));
+    m_renderHeight = (std::max)(1, static_cast<int>(m_height * m_renderScale + 0.5f));
+
     m_viewport.TopLeftX = 0.0f;
     m_viewport.TopLeftY = 0.0f;
-    m_viewport.Width = static_cast<float>(m_width);
-    m_viewport.Height = static_cast<float>(m_height);
+    m_viewport.Width = static_cast<float>(m_renderWidth);
+    m_viewport.Height = static_cast<float>(m_renderHeight);
     m_viewport.MinDepth = 0.0f;
     m_viewport.MaxDepth = 1.0f;
     
     m_scissorRect.left = 0;
     m_scissorRect.top = 0;
-    m_scissorRect.right = m_width;
-    m_scissorRect.bottom = m_height;
+    m_scissorRect.right = m_renderWidth;
+    m_scissorRect.bottom = m_renderHeight;
+
+    m_outputViewport = m_viewport;
+    m_outputViewport.Width = static_cast<float>(m_width);
+    m_outputViewport.Height = static_cast<float>(m_height);
+
+    m_outputScissorRect.left = 0;
+    m_outputScissorRect.top = 0;
+    m_outputScissorRect.right = m_width;
+    m_outputScissorRect.bottom = m_height;
+}
+
+bool Renderer::Resize(int width, int height) {
+    if (width <= 0 || height <= 0 || (width == m_width && height == m_height)) {
+        return true;
+    }
+
+    // EndFrame waits on the fence, so between frames the GPU holds no
+    // references to the buffers released here.
+    m_renderTargets[0].Reset();
+    m_renderTargets[1].Reset();
+    m_sceneTarget.Reset();
+    m_depthStencilBuffer.Reset();
+
+    if (FAILED(m_swapChain->ResizeBuffers(2, width, height, DXGI_FORMAT_UNKNOWN, 0))) {
+        std::cerr << "Failed to resize swap chain to " << width << "x" << height << "\n";
+        return false;
+    }
+
+    m_width = width;
+    m_height = height;
+    m_currentBackBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
+
+    if (!CreateRenderTargets() || !CreateDepthBuffer() || !CreateSceneTarget()) {
+        return false;
+    }
+
+    UpdateViewport();
+    return true;
+}
+
+void Renderer::SetDynamicResolution(bool enabled) {
+    m_dynamicResolution = enabled;
+    if (!enabled) {
+        m_resolutionController.Reset();
+        m_renderScale = 1.0f;
+        UpdateViewport();
+    }
+}
+
+void Renderer::SetTargetFrameRate(float framesPerSecond) {
+    if (framesPerSecond <= 0.0f) {
+        return;
+    }
+
+    DynamicResolutionSettings settings = m_resolutionController.GetSettings();
+    settings.targetFrameTimeMs = 1000.0f / framesPerSecond;
+    m_resolutionController.SetSettings(settings);
+}
+
+void Renderer::UpdateDynamicResolution() {
+    if (!m_dynamicResolution || m_timestampFrequency == 0) {
+        return;
+    }
+
+    UINT64* timestamps = nullptr;
+    D3D12_RANGE readRange = { 0, 2 * sizeof(UINT64) };
+    if (FAILED(m_timestampReadback->Map(0, &readRange, reinterpret_cast<void**>(&timestamps)))) {
+        return;
+    }
+    UINT64 begin = timestamps[0];
+    UINT64 end = timestamps[1];
+    D3D12_RANGE writeRange = { 0, 0 };
+    m_timestampReadback->Unmap(0, &writeRange);
+
+    if (end <= begin) {
+        return;
+    }
+
+    float gpuFrameTimeMs = static_cast<float>(
+        static_cast<double>(end - begin) * 1000.0 / static_cast<double>(m_timestampFrequency));
+    float scale = m_resolutionController.Update(gpuFrameTimeMs);
+    if (scale != m_renderScale) {
+        m_renderScale = scale;
+        UpdateViewport();
+    }
 }
 
 void Renderer::BeginFrame() {
+    UpdateHotReload();
+
+    // The previous frame was fenced in EndFrame, so nothing still references
+    // last frame's scratch allocations.
+    m_frameArena.Reset();
+    m_residency.BeginFrame(++m_frameIndex);
+
     m_commandAllocator->Reset();
     m_commandList->Reset(m_commandAllocator.Get(), m_pipelineState.Get());
+    m_commandList->EndQuery(m_timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 0);
     
     m_currentBackBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
     
     D3D12_RESOURCE_BARRIER barrier = {};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Transition.pResource = m_renderTargets[m_currentBackBufferIndex].Get();
-    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
+    barrier.Transition.pResource = m_sceneTarget.Get();
+    barrier.Transition.StateBefore = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
     barrier.Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
     
     m_commandList->ResourceBarrier(1, &barrier);
     
     UINT rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
     D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
-    rtvHandle.ptr += m_currentBackBufferIndex * rtvDescriptorSize;
+    rtvHandle.ptr += SceneRtvIndex * rtvDescriptorSize;
     
     D3D12_CPU_DESCRIPTOR_HANDLE dsvHandle = m_dsvHeap->GetCPUDescriptorHandleForHeapStart();
     
     m_commandList->OMSetRenderTargets(1, &rtvHandle, FALSE, &dsvHandle);
     
-    float clearColor[] = { 0.2f, 0.2f, 0.3f, 1.0f };
-    m_commandList->ClearRenderTargetView(rtvHandle, clearColor, 0, nullptr);
-    m_commandList->ClearDepthStencilView(dsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 0, nullptr);
+    // Only the scaled region is cleared; the rest of the target is never sampled.
+    m_commandList->ClearRenderTargetView(rtvHandle, SceneClearColor, 1, &m_scissorRect);
+    m_commandList->ClearDepthStencilView(dsvHandle, D3D12_CLEAR_FLAG_DEPTH, 1.0f, 0, 1, &m_scissorRect);
     
     m_commandList->RSSetViewports(1, &m_viewport);
     m_commandList->RSSetScissorRects(1, &m_scissorRect);
     m_commandList->SetGraphicsRootSignature(m_rootSignature.Get());
     m_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+
+    if (ICommandBackend* capture = GetCapture()) {
+        capture->BeginFrame(m_frameIndex);
+        if (m_captureSnapshotPending) {
+            m_geometryPool.RecordSnapshot(*capture);
+
+            BufferDesc argumentDesc = {};
+            argumentDesc.bufferId = IndirectArgumentBufferId;
+            argumentDesc.usage = BufferUsage::IndirectArguments;
+            argumentDesc.sizeInBytes = sizeof(IndirectDrawCommand) * MaxIndirectDraws;
+            argumentDesc.gpuAddress = m_argumentBuffer->GetGPUVirtualAddress();
+            capture->CreateBuffer(argumentDesc);
+
+            BufferDesc countDesc = {};
+            countDesc.bufferId = IndirectCountBufferId;
+            countDesc.usage = BufferUsage::IndirectCount;
+            countDesc.sizeInBytes = sizeof(uint32_t);
+            countDesc.gpuAddress = m_countBuffer->GetGPUVirtualAddress();
+            capture->CreateBuffer(countDesc);
+
+            m_geometryPool.SetCapture(capture);
+            m_captureSnapshotPending = false;
+        }
+
+        capture->SetViewport({ m_viewport.TopLeftX, m_viewport.TopLeftY, m_viewport.Width,
+            m_viewport.Height, m_viewport.MinDepth, m_viewport.MaxDepth });
+        capture->SetPipeline(m_pipelineId);
+        capture->Clear({ { SceneClearColor[0], SceneClearColor[1], SceneClearColor[2], SceneClearColor[3] }, 1.0f });
+    }
 }
 
 void Renderer::Render() {
+    // The resident ranges only live for this frame, so they come from the
+    // frame arena that BeginFrame resets.
+    ArenaMemoryResource frameResource(m_frameArena);
+    std::pmr::vector<GpuMeshRange> ranges(&frameResource);
+    ranges.reserve(m_meshes.size());
     for (const auto& mesh : m_meshes) {
-        m_commandList->IASetVertexBuffers(0, 1, &mesh.vertexBufferView);
-        m_commandList->IASetIndexBuffer(&mesh.indexBufferView);
-        m_commandList->DrawIndexedInstanced(mesh.indexCount, 1, 0, 0, 0);
+        GpuMeshRange range;
+        if (m_residency.Request(mesh.handle, range)) {
+            ranges.push_back(range);
+        }
+    }
+
+    if (m_useIndirectDraw) {
+        SubmitIndirect(ranges);
+    } else {
+        SubmitDirect(ranges);
+    }
+}
+
+void Renderer::SubmitDirect(const std::pmr::vector<GpuMeshRange>& ranges) {
+    m_commandList->IASetVertexBuffers(0, 1, &m_geometryPool.GetVertexBufferView());
+    m_commandList->IASetIndexBuffer(&m_geometryPool.GetIndexBufferView());
+
+    for (const auto& range : ranges) {
+        m_commandList->DrawIndexedInstanced(range.indexCount, 1, range.indexOffset,
+            static_cast<INT>(range.vertexOffset), 0);
+
+        if (ICommandBackend* capture = GetCapture()) {
+            capture->DrawIndexed({ range.indexCount, 1, range.indexOffset,
+                static_cast<int32_t>(range.vertexOffset), 0 });
+        }
+    }
+}
+
+void Renderer::SubmitIndirect(const std::pmr::vector<GpuMeshRange>& ranges) {
+    m_argumentPacker.Begin(m_mappedArguments, MaxIndirectDraws);
+
+    for (const auto& range : ranges) {
+        IndirectDrawCommand command = {};
+        command.draw.indexCountPerInstance = range.indexCount;
+        command.draw.instanceCount = 1;
+        command.draw.startIndexLocation = range.indexOffset;
+        command.draw.baseVertexLocation = static_cast<int32_t>(range.vertexOffset);
+
+        if (!m_argumentPacker.Push(command)) {
+            break;
+        }
+    }
+
+    UINT drawCount = m_argumentPacker.Finish(m_mappedCount);
+    if (drawCount == 0) {
+        return;
+    }
+
+    m_commandList->IASetVertexBuffers(0, 1, &m_geometryPool.GetVertexBufferView());
+    m_commandList->IASetIndexBuffer(&m_geometryPool.GetIndexBufferView());
+    m_commandList->ExecuteIndirect(m_commandSignature.Get(), drawCount,
+        m_argumentBuffer.Get(), 0, m_countBuffer.Get(), 0);
+
+    if (ICommandBackend* capture = GetCapture()) {
+        capture->UploadBuffer(IndirectArgumentBufferId, 0, m_mappedArguments,
+            drawCount * sizeof(IndirectDrawCommand));
+        capture->UploadBuffer(IndirectCountBufferId, 0, m_mappedCount, sizeof(uint32_t));
+        capture->ExecuteIndirect(IndirectArgumentBufferId, IndirectCountBufferId, drawCount);
     }
 }
 
+void Renderer::UpscaleToBackBuffer() {
+    D3D12_RESOURCE_BARRIER barriers[2] = {};
+    barriers[0].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barriers[0].Transition.pResource = m_sceneTarget.Get();
+    barriers[0].Transition.StateBefore = D3D12_RESOURCE_STATE_RENDER_TARGET;
+    barriers[0].Transition.StateAfter = D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE;
+    barriers[1].Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+    barriers[1].Transition.pResource = m_renderTargets[m_currentBackBufferIndex].Get();
+    barriers[1].Transition.StateBefore = D3D12_RESOURCE_STATE_PRESENT;
+    barriers[1].Transition.StateAfter = D3D12_RESOURCE_STATE_RENDER_TARGET;
+
+    m_commandList->ResourceBarrier(2, barriers);
+
+    UINT rtvDescriptorSize = m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+    D3D12_CPU_DESCRIPTOR_HANDLE rtvHandle = m_rtvHeap->GetCPUDescriptorHandleForHeapStart();
+    rtvHandle.ptr += m_currentBackBufferIndex * rtvDescriptorSize;
+
+    m_commandList->OMSetRenderTargets(1, &rtvHandle, FALSE, nullptr);
+    m_commandList->RSSetViewports(1, &m_outputViewport);
+    m_commandList->RSSetScissorRects(1, &m_outputScissorRect);
+    m_commandList->SetPipelineState(m_upscalePipelineState.Get());
+    m_commandList->SetGraphicsRootSignature(m_upscaleRootSignature.Get());
+
+    ID3D12DescriptorHeap* heaps[] = { m_srvHeap.Get() };
+    m_commandList->SetDescriptorHeaps(1, heaps);
+    m_commandList->SetGraphicsRootDescriptorTable(0, m_srvHeap->GetGPUDescriptorHandleForHeapStart());
+
+    // UVs are clamped half a texel inside the rendered region so bilinear
+    // filtering never pulls in stale pixels from outside it.
+    float width = static_cast<float>(m_width);
+    float height = static_cast<float>(m_height);
+    float constants[4] = {
+        m_renderWidth / width, m_renderHeight / height,
+        (m_renderWidth - 0.5f) / width, (m_renderHeight - 0.5f) / height
+    };
+    m_commandList->SetGraphicsRoot32BitConstants(1, 4, constants, 0);
+    m_commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+    m_commandList->DrawInstanced(3, 1, 0, 0);
+}
+
 void Renderer::EndFrame() {
+    UpscaleToBackBuffer();
+
     D3D12_RESOURCE_BARRIER barrier = {};
     barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
     barrier.Transition.pResource = m_renderTargets[m_currentBackBufferIndex].Get();
@@ -378,6 +1027,10 @@ void Renderer::EndFrame() {
 
     m_commandList->ResourceBarrier(1, &barrier);
 
+    m_commandList->EndQuery(m_timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 1);
+    m_commandList->ResolveQueryData(m_timestampHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 0, 2,
+        m_timestampReadback.Get(), 0);
+
     m_commandList->Close();
 
     ID3D12CommandList* commandLists[] = { m_commandList.Get() };
@@ -393,14 +1046,82 @@ void Renderer::EndFrame() {
         m_fence->SetEventOnCompletion(fenceValue, m_fenceEvent);
         WaitForSingleObject(m_fenceEvent, INFINITE);
     }
+
+    UpdateDynamicResolution();
+
+    if (ICommandBackend* capture = GetCapture()) {
+        capture->EndFrame();
+        if (--m_captureFramesRemaining == 0) {
+            StopCapture();
+        }
+    }
+}
+
+bool Renderer::StartCapture(const std::string& path, uint32_t frameCount) {
+    if (IsCapturing() || frameCount == 0) {
+        return false;
+    }
+
+    if (!m_captureWriter.Open(path)) {
+        std::cerr << "Failed to open capture file " << path << "\n";
+        return false;
+    }
+
+    // Buffers are snapshotted at the start of the next frame so the capture
+    // replays on its own.
+    m_captureFramesRemaining = frameCount;
+    m_captureSnapshotPending = true;
+    return true;
+}
+
+void Renderer::StopCapture() {
+    if (!IsCapturing()) {
+        return;
+    }
+
+    m_geometryPool.SetCapture(nullptr);
+    m_captureWriter.Close();
+    std::cout << "Captured " << m_captureWriter.GetFramesWritten() << " frame(s), "
+        << m_captureWriter.GetCompressedBytes() << " bytes\n";
 }
 
 void Renderer::Shutdown() {
+    if (m_pendingPipeline.valid()) {
+        m_pendingPipeline.wait();
+    }
+    if (m_pendingUpscalePipeline.valid()) {
+        m_pendingUpscalePipeline.wait();
+    }
+    m_pendingPipeline = {};
+    m_pendingUpscalePipeline = {};
+    m_pendingMeshes.clear();
+    m_fileWatcher.Shutdown();
+    StopCapture();
+
     if (m_fenceEvent) {
         CloseHandle(m_fenceEvent);
         m_fenceEvent = nullptr;
     }
     
+    if (m_argumentBuffer && m_mappedArguments) {
+        m_argumentBuffer->Unmap(0, nullptr);
+        m_mappedArguments = nullptr;
+    }
+    if (m_countBuffer && m_mappedCount) {
+        m_countBuffer->Unmap(0, nullptr);
+        m_mappedCount = nullptr;
+    }
+
+    m_geometryPool.Shutdown();
+    m_timestampReadback.Reset();
+    m_timestampHeap.Reset();
+    m_upscalePipelineState.Reset();
+    m_upscaleRootSignature.Reset();
+    m_sceneTarget.Reset();
+    m_srvHeap.Reset();
+    m_countBuffer.Reset();
+    m_argumentBuffer.Reset();
+    m_commandSignature.Reset();
     m_fence.Reset();
     m_pipelineState.Reset();
     m_rootSignature.Reset();
@@ -4,12 +4,49 @@
 #include <dxgi1_6.h>
 #include <DirectXMath.h>
 #include <wrl/client.h>
+#include <future>
+#include <memory_resource>
+#include <string>
 #include <vector>
 #include "Mesh.h"
+#include "GeometryPool.h"
+#include "GeometryGenerators.h"
+#include "ResidencyManager.h"
+#include "IndirectDraw.h"
+#include "Memory.h"
+#include "ShaderCompiler.h"
+#include "FileWatcher.h"
+#include "DependencyTracker.h"
+#include "FrameCapture.h"
+#include "DynamicResolution.h"
 
 using Microsoft::WRL::ComPtr;
 using namespace DirectX;
 
+struct ShaderBuild {
+    ComPtr<ID3DBlob> bytecode;
+    std::vector<std::string> dependencies;
+    bool compiled = false;
+};
+
+struct PipelineBuild {
+    ShaderBuild vertexShader;
+    ShaderBuild pixelShader;
+    ComPtr<ID3D12PipelineState> pipelineState;
+};
+
+struct MeshAsset {
+    std::string target;
+    std::string path;
+    MeshHandle handle;
+};
+
+struct MeshLoadResult {
+    MeshHandle handle;
+    MeshData data;
+    bool loaded = false;
+};
+
 class Renderer{
 public:
     Renderer();
@@ -20,6 +57,19 @@ public:
     void Render();
     void EndFrame();
     void Shutdown();
+    ResidencyManager& GetResidencyManager() { return m_residency; }
+
+    bool StartCapture(const std::string& path, uint32_t frameCount);
+    void StopCapture();
+    bool IsCapturing() const { return m_captureWriter.IsOpen(); }
+
+    // Recreates the swap chain buffers and size-dependent targets in place.
+    // Must be called between frames.
+    bool Resize(int width, int height);
+
+    void SetDynamicResolution(bool enabled);
+    void SetTargetFrameRate(float framesPerSecond);
+    float GetRenderScale() const { return m_renderScale; }
 
 private:
     bool InitializeDirectX(HWND hwnd, int width, int height);
@@ -27,10 +77,30 @@ private:
     bool CreateSwapChain(HWND hwnd);
     bool CreateRenderTargets();
     bool CreateDepthBuffer();
+    bool CreateSceneTarget();
     bool CreateRootSignature();
     bool CreatePipelineState();
-    void CreateMeshes();
+    bool BuildPipelineState(ID3DBlob* vertexShader, ID3DBlob* pixelShader,
+        ComPtr<ID3D12PipelineState>& pipelineState) const;
+    bool CreateUpscalePipeline();
+    bool BuildUpscalePipelineState(ID3DBlob* vertexShader, ID3DBlob* pixelShader,
+        ComPtr<ID3D12PipelineState>& pipelineState) const;
+    using PipelineBuilder = bool (Renderer::*)(ID3DBlob*, ID3DBlob*, ComPtr<ID3D12PipelineState>&) const;
+    // Compiles whichever shader is null on a worker thread, then builds the
+    // pipeline state with builder.
+    std::future<PipelineBuild> StartPipelineBuild(const ShaderDesc& vertexDesc, const ShaderDesc& pixelDesc,
+        ComPtr<ID3DBlob> vertexShader, ComPtr<ID3DBlob> pixelShader, PipelineBuilder builder);
+    bool CreateTimestampQueries();
+    bool CreateIndirectResources();
+    bool CreateMeshes();
+    void InitializeHotReload();
+    void UpdateHotReload();
     void UpdateViewport();
+    void UpdateDynamicResolution();
+    void UpscaleToBackBuffer();
+    void SubmitDirect(const std::pmr::vector<GpuMeshRange>& ranges);
+    void SubmitIndirect(const std::pmr::vector<GpuMeshRange>& ranges);
+    ICommandBackend* GetCapture() { return m_captureWriter.IsOpen() ? &m_captureWriter : nullptr; }
 
     ComPtr<ID3D12Device> m_device;
     ComPtr<IDXGIFactory4> m_factory;
@@ -48,8 +118,58 @@ private:
     ComPtr<ID3D12PipelineState> m_pipelineState;
     ComPtr<ID3D12Fence> m_fence;
 
+    static constexpr UINT MaxIndirectDraws = 4096;
+    ComPtr<ID3D12CommandSignature> m_commandSignature;
+    ComPtr<ID3D12Resource> m_argumentBuffer;
+    ComPtr<ID3D12Resource> m_countBuffer;
+    IndirectDrawCommand* m_mappedArguments;
+    uint32_t* m_mappedCount;
+    IndirectArgumentPacker m_argumentPacker;
+    bool m_useIndirectDraw;
+
+    static constexpr size_t FrameArenaCapacity = 4 * 1024 * 1024;
+    LinearArena m_frameArena;
+
+    // The budget is the pool: 44 MB committed up front (28 MB of vertices,
+    // 16 MB of indices), so residency evicts before the pool runs out rather
+    // than leaving part of it unused.
+    static constexpr uint32_t MaxPoolVertices = 1 << 20;
+    static constexpr uint32_t MaxPoolIndices = 1 << 22;
+    static constexpr uint64_t DefaultGeometryBudget =
+        uint64_t(MaxPoolVertices) * sizeof(Vertex) + uint64_t(MaxPoolIndices) * sizeof(uint32_t);
+    GeometryPool m_geometryPool;
+    ResidencyManager m_residency;
+    uint64_t m_frameIndex;
+
     std::vector<Mesh> m_meshes;
 
+    std::string m_assetDirectory;
+    ShaderDesc m_vertexShaderDesc;
+    ShaderDesc m_pixelShaderDesc;
+    ComPtr<ID3DBlob> m_vertexShader;
+    ComPtr<ID3DBlob> m_pixelShader;
+    ShaderDesc m_upscaleVertexShaderDesc;
+    ShaderDesc m_upscalePixelShaderDesc;
+    ComPtr<ID3DBlob> m_upscaleVertexShader;
+    ComPtr<ID3DBlob> m_upscalePixelShader;
+    std::vector<MeshAsset> m_meshAssets;
+    FileWatcher m_fileWatcher;
+    DependencyTracker m_dependencies;
+    std::future<PipelineBuild> m_pendingPipeline;
+    std::future<PipelineBuild> m_pendingUpscalePipeline;
+    std::vector<std::future<MeshLoadResult>> m_pendingMeshes;
+    bool m_vertexShaderDirty;
+    bool m_pixelShaderDirty;
+    bool m_upscaleVertexShaderDirty;
+    bool m_upscalePixelShaderDirty;
+    uint32_t m_pipelineId;
+
+    static constexpr uint32_t IndirectArgumentBufferId = 2;
+    static constexpr uint32_t IndirectCountBufferId = 3;
+    CaptureWriter m_captureWriter;
+    uint32_t m_captureFramesRemaining;
+    bool m_captureSnapshotPending;
+
     int m_width;
     int m_height;
     int m_currentBackBufferIndex;
@@ -58,4 +178,22 @@ private:
 
     D3D12_VIEWPORT m_viewport;
     D3D12_RECT m_scissorRect;
+
+    // The scene is drawn into the top-left m_renderWidth x m_renderHeight
+    // region of a full-size offscreen target and upscaled to the back buffer.
+    static constexpr UINT SceneRtvIndex = 2;
+    ComPtr<ID3D12Resource> m_sceneTarget;
+    ComPtr<ID3D12DescriptorHeap> m_srvHeap;
+    ComPtr<ID3D12RootSignature> m_upscaleRootSignature;
+    ComPtr<ID3D12PipelineState> m_upscalePipelineState;
+    ComPtr<ID3D12QueryHeap> m_timestampHeap;
+    ComPtr<ID3D12Resource> m_timestampReadback;
+    UINT64 m_timestampFrequency;
+    DynamicResolutionController m_resolutionController;
+    bool m_dynamicResolution;
+    float m_renderScale;
+    int m_renderWidth;
+    int m_renderHeight;
+    D3D12_VIEWPORT m_outputViewport;
+    D3D12_RECT m_outputScissorRect;
 };
\ No newline at end of file
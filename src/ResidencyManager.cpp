@@ -0,0 +1,234 @@
+#include "ResidencyManager.h"
+
+ResidencyManager::ResidencyManager(IGeometryDevice& device, uint64_t budgetBytes)
+    : m_device(device), m_budgetBytes(budgetBytes), m_residentBytes(0),
+    m_frame(0), m_uploadCount(0), m_evictionCount(0) {}
+
+MeshHandle ResidencyManager::Register(MeshData&& data, MeshSource source) {
+    if (data.IsEmpty()) {
+        return InvalidMeshHandle;
+    }
+
+    MeshHandle handle = AllocateHandle();
+    Entry& entry = m_entries[handle];
+    entry.sizeInBytes = data.GetSizeInBytes();
+    entry.data = std::move(data);
+    entry.source = std::move(source);
+    entry.lastUsedFrame = m_frame;
+    entry.registered = true;
+    entry.resident = false;
+    entry.cpuDataReleased = false;
+
+    // Upload eagerly so callers can release the CPU copy straight away.
+    MakeResident(entry);
+    return handle;
+}
+
+MeshHandle ResidencyManager::RegisterStatic(const MeshView& mesh) {
+    if (!mesh.vertices || !mesh.indices || mesh.vertexCount == 0 || mesh.indexCount == 0) {
+        return InvalidMeshHandle;
+    }
+
+    MeshHandle handle = AllocateHandle();
+    Entry& entry = m_entries[handle];
+    entry.staticView = mesh;
+    entry.sizeInBytes = mesh.GetSizeInBytes();
+    entry.lastUsedFrame = m_frame;
+    entry.registered = true;
+
+    MakeResident(entry);
+    return handle;
+}
+
+MeshHandle ResidencyManager::AllocateHandle() {
+    if (!m_freeHandles.empty()) {
+        MeshHandle handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        return handle;
+    }
+
+    m_entries.emplace_back();
+    return static_cast<MeshHandle>(m_entries.size() - 1);
+}
+
+void ResidencyManager::Unregister(MeshHandle handle) {
+    if (handle >= m_entries.size() || !m_entries[handle].registered) {
+        return;
+    }
+
+    Entry& entry = m_entries[handle];
+    if (entry.resident) {
+        Evict(entry);
+    }
+    entry = Entry();
+    m_freeHandles.push_back(handle);
+}
+
+bool ResidencyManager::Replace(MeshHandle handle, MeshData&& data) {
+    if (handle >= m_entries.size() || !m_entries[handle].registered || data.IsEmpty()) {
+        return false;
+    }
+
+    Entry& entry = m_entries[handle];
+    if (entry.resident) {
+        Evict(entry);
+    }
+
+    entry.sizeInBytes = data.GetSizeInBytes();
+    entry.data = std::move(data);
+    entry.staticView = {};
+    entry.cpuDataReleased = false;
+    return MakeResident(entry);
+}
+
+bool ResidencyManager::Request(MeshHandle handle, GpuMeshRange& range) {
+    if (handle >= m_entries.size() || !m_entries[handle].registered) {
+        return false;
+    }
+
+    Entry& entry = m_entries[handle];
+    entry.lastUsedFrame = m_frame;
+    if (!entry.resident && !MakeResident(entry)) {
+        return false;
+    }
+
+    range = entry.range;
+    return true;
+}
+
+bool ResidencyManager::ReleaseCpuData(MeshHandle handle) {
+    if (handle >= m_entries.size() || !m_entries[handle].registered) {
+        return false;
+    }
+
+    // Without a source the GPU copy is the only one left, so the mesh is
+    // pinned: CanEvict refuses it from here on.
+    Entry& entry = m_entries[handle];
+    if (entry.staticView.vertices) {
+        return true;
+    }
+    if (!entry.resident && !entry.source) {
+        return false;
+    }
+
+    entry.data.Release();
+    entry.cpuDataReleased = true;
+    return true;
+}
+
+bool ResidencyManager::IsResident(MeshHandle handle) const {
+    return handle < m_entries.size() && m_entries[handle].resident;
+}
+
+void ResidencyManager::SetBudget(uint64_t budgetBytes) {
+    m_budgetBytes = budgetBytes;
+    while (m_residentBytes > m_budgetBytes && EvictLeastRecentlyUsed()) {
+    }
+}
+
+uint64_t ResidencyManager::GetCpuBytes() const {
+    uint64_t total = 0;
+    for (const auto& entry : m_entries) {
+        total += entry.data.GetCapacityInBytes();
+    }
+    return total;
+}
+
+bool ResidencyManager::MakeResident(Entry& entry) {
+    if (entry.resident) {
+        return true;
+    }
+
+    bool restored = false;
+    if (entry.cpuDataReleased) {
+        if (!entry.source || !entry.source(entry.data) || entry.data.IsEmpty()) {
+            entry.data.Release();
+            return false;
+        }
+        entry.sizeInBytes = entry.data.GetSizeInBytes();
+        restored = true;
+    }
+
+    // Only evict when that can make room: meshes that cannot be evicted stay,
+    // and a mesh larger than what is left beside them would otherwise flush
+    // the whole cache and still fail. The same bound covers the retries for
+    // a fragmented pool below.
+    bool uploaded = false;
+    bool fits = true;
+    if (m_residentBytes + entry.sizeInBytes > m_budgetBytes) {
+        uint64_t evictableBytes = 0;
+        Entry* victim = FindEvictionVictim(evictableBytes);
+        uint64_t pinnedBytes = m_residentBytes - evictableBytes;
+        fits = entry.sizeInBytes <= m_budgetBytes && pinnedBytes <= m_budgetBytes - entry.sizeInBytes;
+        if (fits) {
+            Evict(*victim);
+            ++m_evictionCount;
+            while (m_residentBytes + entry.sizeInBytes > m_budgetBytes && EvictLeastRecentlyUsed()) {
+            }
+        }
+    }
+
+    if (fits) {
+        // The pool may be fragmented even when the budget allows the mesh.
+        MeshView view = entry.staticView.vertices ? entry.staticView : entry.data.GetView();
+        while (!(uploaded = m_device.Upload(view, entry.range))) {
+            if (!EvictLeastRecentlyUsed()) {
+                break;
+            }
+        }
+    }
+
+    if (restored) {
+        entry.data.Release();
+    }
+
+    if (!uploaded) {
+        return false;
+    }
+
+    entry.resident = true;
+    m_residentBytes += entry.sizeInBytes;
+    ++m_uploadCount;
+    return true;
+}
+
+ResidencyManager::Entry* ResidencyManager::FindEvictionVictim(uint64_t& evictableBytes) {
+    Entry* victim = nullptr;
+    evictableBytes = 0;
+    for (auto& entry : m_entries) {
+        if (!CanEvict(entry)) {
+            continue;
+        }
+        evictableBytes += entry.sizeInBytes;
+        if (!victim || entry.lastUsedFrame < victim->lastUsedFrame) {
+            victim = &entry;
+        }
+    }
+    return victim;
+}
+
+bool ResidencyManager::EvictLeastRecentlyUsed() {
+    uint64_t evictableBytes = 0;
+    Entry* victim = FindEvictionVictim(evictableBytes);
+    if (!victim) {
+        return false;
+    }
+
+    Evict(*victim);
+    ++m_evictionCount;
+    return true;
+}
+
+void ResidencyManager::Evict(Entry& entry) {
+    m_device.Evict(entry.range);
+    entry.range = {};
+    entry.resident = false;
+    m_residentBytes -= entry.sizeInBytes;
+}
+
+bool ResidencyManager::CanEvict(const Entry& entry) const {
+    if (!entry.registered || !entry.resident || entry.lastUsedFrame >= m_frame) {
+        return false;
+    }
+    return entry.staticView.vertices || !entry.cpuDataReleased || static_cast<bool>(entry.source);
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "Geometry.h"
+
+using MeshHandle = uint32_t;
+constexpr MeshHandle InvalidMeshHandle = UINT32_MAX;
+
+// Location of a resident mesh inside the pooled vertex and index buffers,
+// in elements rather than bytes.
+struct GpuMeshRange {
+    uint32_t vertexOffset;
+    uint32_t vertexCount;
+    uint32_t indexOffset;
+    uint32_t indexCount;
+};
+
+// Backend that owns GPU geometry storage. GeometryPool implements it on
+// D3D12; anything else (a mock, a null device) can stand in for it.
+class IGeometryDevice {
+public:
+    virtual ~IGeometryDevice() = default;
+
+    virtual bool Upload(const MeshView& mesh, GpuMeshRange& range) = 0;
+    virtual void Evict(const GpuMeshRange& range) = 0;
+};
+
+// Rebuilds a mesh's CPU data when it must be restored after eviction.
+using MeshSource = std::function<bool(MeshData& data)>;
+
+// Tracks which meshes are resident on the GPU and keeps the resident total
+// under a byte budget, evicting the least recently used meshes first. A mesh
+// used in the current frame is never evicted, so ranges handed out by Request
+// stay valid until the next BeginFrame. Whether an eviction gives memory back
+// is up to the device; with GeometryPool it only frees space inside the pool.
+class ResidencyManager {
+public:
+    ResidencyManager(IGeometryDevice& device, uint64_t budgetBytes);
+
+    void BeginFrame(uint64_t frame) { m_frame = frame; }
+
+    MeshHandle Register(MeshData&& data, MeshSource source = nullptr);
+    // Registers geometry that lives in static storage for the lifetime of
+    // the program (see StaticMesh); it is restored from there on demand.
+    MeshHandle RegisterStatic(const MeshView& mesh);
+    void Unregister(MeshHandle handle);
+    // Swaps in new geometry for an existing handle, e.g. after a hot reload.
+    // Only call between frames: the old GPU range is released immediately.
+    bool Replace(MeshHandle handle, MeshData&& data);
+
+    bool Request(MeshHandle handle, GpuMeshRange& range);
+    bool ReleaseCpuData(MeshHandle handle);
+    bool IsResident(MeshHandle handle) const;
+
+    void SetBudget(uint64_t budgetBytes);
+    uint64_t GetBudget() const { return m_budgetBytes; }
+    uint64_t GetResidentBytes() const { return m_residentBytes; }
+    uint64_t GetCpuBytes() const;
+    uint64_t GetUploadCount() const { return m_uploadCount; }
+    uint64_t GetEvictionCount() const { return m_evictionCount; }
+
+private:
+    struct Entry {
+        MeshData data;
+        MeshSource source;
+        MeshView staticView = {};
+        GpuMeshRange range = {};
+        uint64_t sizeInBytes = 0;
+        uint64_t lastUsedFrame = 0;
+        bool registered = false;
+        bool resident = false;
+        bool cpuDataReleased = false;
+    };
+
+    MeshHandle AllocateHandle();
+    bool MakeResident(Entry& entry);
+    bool EvictLeastRecentlyUsed();
+    // Least recently used evictable mesh, or null; also sums the bytes of
+    // every evictable mesh.
+    Entry* FindEvictionVictim(uint64_t& evictableBytes);
+    void Evict(Entry& entry);
+    bool CanEvict(const Entry& entry) const;
+
+    IGeometryDevice& m_device;
+    std::vector<Entry> m_entries;
+    std::vector<MeshHandle> m_freeHandles;
+    uint64_t m_budgetBytes;
+    uint64_t m_residentBytes;
+    uint64_t m_frame;
+    uint64_t m_uploadCount;
+    uint64_t m_evictionCount;
+};
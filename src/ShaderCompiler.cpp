@@ -0,0 +1,84 @@
+#include "ShaderCompiler.h"
+#include "DependencyTracker.h"
+#include <d3dcompiler.h>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace {
+    bool ReadTextFile(const std::string& path, std::string& contents) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            return false;
+        }
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // Resolves #include relative to the shader directory and records every
+    // file it opens.
+    class IncludeHandler : public ID3DInclude {
+    public:
+        IncludeHandler(const std::string& directory, std::vector<std::string>& dependencies)
+            : m_directory(directory), m_dependencies(dependencies) {}
+
+        HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR fileName, LPCVOID, LPCVOID* data, UINT* bytes) override {
+            std::string path = NormalizePath(m_directory + "/" + fileName);
+            std::string contents;
+            if (!ReadTextFile(path, contents)) {
+                return E_FAIL;
+            }
+
+            char* buffer = new char[contents.size()];
+            contents.copy(buffer, contents.size());
+            *data = buffer;
+            *bytes = static_cast<UINT>(contents.size());
+            m_dependencies.push_back(path);
+            return S_OK;
+        }
+
+        HRESULT __stdcall Close(LPCVOID data) override {
+            delete[] static_cast<const char*>(data);
+            return S_OK;
+        }
+
+    private:
+        std::string m_directory;
+        std::vector<std::string>& m_dependencies;
+    };
+}
+
+bool CompileShaderFile(const std::string& directory, const ShaderDesc& desc,
+    ComPtr<ID3DBlob>& bytecode, std::vector<std::string>& dependencies) {
+    std::string path = NormalizePath(directory + "/" + desc.file);
+    std::string source;
+    if (!ReadTextFile(path, source)) {
+        std::cerr << "Failed to read shader " << path << "\n";
+        return false;
+    }
+
+    std::vector<D3D_SHADER_MACRO> macros;
+    for (const auto& define : desc.defines) {
+        macros.push_back({ define.name.c_str(), define.value.c_str() });
+    }
+    macros.push_back({ nullptr, nullptr });
+
+    std::vector<std::string> includes;
+    IncludeHandler includeHandler(directory, includes);
+
+    ComPtr<ID3DBlob> blob;
+    ComPtr<ID3DBlob> error;
+    if (FAILED(D3DCompile(source.data(), source.size(), path.c_str(), macros.data(), &includeHandler,
+        desc.entryPoint.c_str(), desc.target.c_str(), 0, 0, &blob, &error))) {
+        if (error) {
+            std::cerr << desc.name << " compile error: " << (char*)error->GetBufferPointer() << "\n";
+        }
+        return false;
+    }
+
+    bytecode = blob;
+    dependencies.clear();
+    dependencies.push_back(path);
+    dependencies.insert(dependencies.end(), includes.begin(), includes.end());
+    return true;
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <d3dcommon.h>
+#include <wrl/client.h>
+#include <string>
+#include <vector>
+
+using Microsoft::WRL::ComPtr;
+
+struct ShaderMacro {
+    std::string name;
+    std::string value;
+};
+
+// One shader permutation: a source file, entry point, profile and defines.
+struct ShaderDesc {
+    std::string name;
+    std::string file;
+    std::string entryPoint;
+    std::string target;
+    std::vector<ShaderMacro> defines;
+};
+
+// Compiles desc.file from directory. On success, dependencies receives the
+// normalized path of the source file and of every header it included.
+bool CompileShaderFile(const std::string& directory, const ShaderDesc& desc,
+    ComPtr<ID3DBlob>& bytecode, std::vector<std::string>& dependencies);
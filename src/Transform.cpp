@@ -0,0 +1,123 @@
+#include "Transform.h"
+#include "Parallel.h"
+#include <cmath>
+
+namespace {
+    constexpr uint32_t TransformGrainSize = 1024;
+
+    Float3 Subtract(const Float3& a, const Float3& b) {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    float Dot(const Float3& a, const Float3& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    Float3 Cross(const Float3& a, const Float3& b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    Float3 Normalize(const Float3& v) {
+        float length = std::sqrt(Dot(v, v));
+        if (length == 0.0f) {
+            return v;
+        }
+        return { v.x / length, v.y / length, v.z / length };
+    }
+}
+
+Float4x4 MakeIdentity() {
+    return { {
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.0f, 0.0f },
+        { 0.0f, 0.0f, 0.0f, 1.0f },
+    } };
+}
+
+Float4x4 Multiply(const Float4x4& a, const Float4x4& b) {
+    Float4x4 result;
+    for (int row = 0; row < 4; ++row) {
+        for (int column = 0; column < 4; ++column) {
+            result.m[row][column] =
+                a.m[row][0] * b.m[0][column] +
+                a.m[row][1] * b.m[1][column] +
+                a.m[row][2] * b.m[2][column] +
+                a.m[row][3] * b.m[3][column];
+        }
+    }
+    return result;
+}
+
+Float3 TransformPoint(const Float3& point, const Float4x4& matrix) {
+    const auto& m = matrix.m;
+    return {
+        point.x * m[0][0] + point.y * m[1][0] + point.z * m[2][0] + m[3][0],
+        point.x * m[0][1] + point.y * m[1][1] + point.z * m[2][1] + m[3][1],
+        point.x * m[0][2] + point.y * m[1][2] + point.z * m[2][2] + m[3][2],
+    };
+}
+
+Float4x4 ComposeWorldMatrix(const Transform& transform) {
+    float cp = std::cos(transform.rotation.x);
+    float sp = std::sin(transform.rotation.x);
+    float cy = std::cos(transform.rotation.y);
+    float sy = std::sin(transform.rotation.y);
+    float cr = std::cos(transform.rotation.z);
+    float sr = std::sin(transform.rotation.z);
+
+    // Roll about Z, then pitch about X, then yaw about Y, expanded so the
+    // whole composition costs one pass instead of three matrix multiplies.
+    float r00 = cr * cy + sr * sp * sy;
+    float r01 = sr * cp;
+    float r02 = sr * sp * cy - cr * sy;
+    float r10 = cr * sp * sy - sr * cy;
+    float r11 = cr * cp;
+    float r12 = sr * sy + cr * sp * cy;
+    float r20 = cp * sy;
+    float r21 = -sp;
+    float r22 = cp * cy;
+
+    const Float3& s = transform.scale;
+    const Float3& t = transform.position;
+    return { {
+        { r00 * s.x, r01 * s.x, r02 * s.x, 0.0f },
+        { r10 * s.y, r11 * s.y, r12 * s.y, 0.0f },
+        { r20 * s.z, r21 * s.z, r22 * s.z, 0.0f },
+        { t.x, t.y, t.z, 1.0f },
+    } };
+}
+
+Float4x4 MakeLookAtLH(const Float3& eye, const Float3& target, const Float3& up) {
+    Float3 zAxis = Normalize(Subtract(target, eye));
+    Float3 xAxis = Normalize(Cross(up, zAxis));
+    Float3 yAxis = Cross(zAxis, xAxis);
+
+    return { {
+        { xAxis.x, yAxis.x, zAxis.x, 0.0f },
+        { xAxis.y, yAxis.y, zAxis.y, 0.0f },
+        { xAxis.z, yAxis.z, zAxis.z, 0.0f },
+        { -Dot(xAxis, eye), -Dot(yAxis, eye), -Dot(zAxis, eye), 1.0f },
+    } };
+}
+
+Float4x4 MakePerspectiveFovLH(float fovY, float aspectRatio, float nearZ, float farZ) {
+    float yScale = 1.0f / std::tan(fovY * 0.5f);
+    float xScale = yScale / aspectRatio;
+    float range = farZ / (farZ - nearZ);
+
+    return { {
+        { xScale, 0.0f, 0.0f, 0.0f },
+        { 0.0f, yScale, 0.0f, 0.0f },
+        { 0.0f, 0.0f, range, 1.0f },
+        { 0.0f, 0.0f, -range * nearZ, 0.0f },
+    } };
+}
+
+void ComposeWorldMatrices(const Transform* transforms, uint32_t count, Float4x4* output) {
+    ParallelFor(count, TransformGrainSize, [transforms, output](uint32_t begin, uint32_t end) {
+        for (uint32_t i = begin; i < end; ++i) {
+            output[i] = ComposeWorldMatrix(transforms[i]);
+        }
+    });
+}
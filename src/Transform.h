@@ -0,0 +1,33 @@
+#pragma once
+#include <cstdint>
+#include "Geometry.h"
+
+// Row-major 4x4 matrix using the same row-vector convention as DirectXMath
+// (v' = v * M), so it can be copied straight into an XMFLOAT4X4.
+struct Float4x4 {
+    float m[4][4];
+};
+
+// Mirrors the position/rotation/scale of a Mesh instance. rotation holds
+// pitch, yaw and roll in radians, applied like XMMatrixRotationRollPitchYaw.
+struct Transform {
+    Float3 position;
+    Float3 rotation;
+    Float3 scale;
+};
+
+Float4x4 MakeIdentity();
+Float4x4 Multiply(const Float4x4& a, const Float4x4& b);
+Float3 TransformPoint(const Float3& point, const Float4x4& matrix);
+
+// scale * rotation * translation.
+Float4x4 ComposeWorldMatrix(const Transform& transform);
+
+// Left-handed view and projection matching XMMatrixLookAtLH and
+// XMMatrixPerspectiveFovLH (clip-space depth in [0, w]).
+Float4x4 MakeLookAtLH(const Float3& eye, const Float3& target, const Float3& up);
+Float4x4 MakePerspectiveFovLH(float fovY, float aspectRatio, float nearZ, float farZ);
+
+// Computes world matrices for count transforms, split across workers with
+// ParallelFor.
+void ComposeWorldMatrices(const Transform* transforms, uint32_t count, Float4x4* output);
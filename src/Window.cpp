@@ -1,7 +1,7 @@
 #include "Window.h"
 #include <stdexcept>
 
-Window::Window() : m_hwnd(nullptr), m_width(0), m_height(0) {}
+Window::Window() : m_hwnd(nullptr), m_width(0), m_height(0), m_resized(false) {}
 
 Window::~Window() {
     Shutdown();
@@ -39,7 +39,7 @@ bool Window::Initialize(int width, int height, const char* title) {
         nullptr,
         nullptr,
         hInstance,
-        nullptr
+        this
     );
 
     if(!m_hwnd){
@@ -50,6 +50,17 @@ bool Window::Initialize(int width, int height, const char* title) {
     return true;
 }
 
+bool Window::ConsumeResize(int& width, int& height) {
+    if (!m_resized) {
+        return false;
+    }
+
+    m_resized = false;
+    width = m_width;
+    height = m_height;
+    return true;
+}
+
 void Window::Shutdown() {
     if(m_hwnd) {
         DestroyWindow(m_hwnd);
@@ -58,8 +69,26 @@ void Window::Shutdown() {
 }
 
 LRESULT CALLBACK Window::WindowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam) {
+    Window* window = reinterpret_cast<Window*>(GetWindowLongPtrW(hwnd, GWLP_USERDATA));
+
     switch (msg)
     {
+    case WM_NCCREATE: {
+        const CREATESTRUCTW* create = reinterpret_cast<const CREATESTRUCTW*>(lparam);
+        SetWindowLongPtrW(hwnd, GWLP_USERDATA, reinterpret_cast<LONG_PTR>(create->lpCreateParams));
+        break;
+    }
+    case WM_SIZE: {
+        int width = LOWORD(lparam);
+        int height = HIWORD(lparam);
+        if (window && wparam != SIZE_MINIMIZED && width > 0 && height > 0 &&
+            (width != window->m_width || height != window->m_height)) {
+            window->m_width = width;
+            window->m_height = height;
+            window->m_resized = true;
+        }
+        return 0;
+    }
     case WM_DESTROY:
         PostQuitMessage(0);
         return 0;
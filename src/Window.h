@@ -16,11 +16,16 @@ public:
     int GetWidth() const { return m_width; }
     int GetHeight() const { return m_height; }
 
+    // Returns true once per resize with the new client size. Minimised
+    // windows report nothing until they are restored.
+    bool ConsumeResize(int& width, int& height);
+
 private:
     static LRESULT CALLBACK WindowProc(HWND hwnd, UINT msg, WPARAM wparam, LPARAM lparam);
 
     HWND m_hwnd;
     int m_width;
     int m_height;
+    bool m_resized;
     std::string m_title;
 };
\ No newline at end of file
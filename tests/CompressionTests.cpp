@@ -0,0 +1,133 @@
+#include "Test.h"
+#include "Compression.h"
+#include <random>
+#include <vector>
+
+namespace {
+    std::vector<uint8_t> MakeCaptureLikeData(size_t size) {
+        // Repeated records with a changing field, like a captured frame.
+        std::vector<uint8_t> data(size);
+        std::mt19937 random(42);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = (i % 20 < 4) ? static_cast<uint8_t>(i / 20) : static_cast<uint8_t>(i % 20);
+            if (i % 97 == 0) {
+                data[i] = static_cast<uint8_t>(random());
+            }
+        }
+        return data;
+    }
+
+    bool RoundTrips(const std::vector<uint8_t>& data) {
+        std::vector<uint8_t> compressed;
+        std::vector<uint8_t> decompressed;
+        CompressBlock(data.data(), data.size(), compressed);
+        return DecompressBlock(compressed.data(), compressed.size(), decompressed, data.size()) &&
+            decompressed == data;
+    }
+}
+
+TEST(Compression, RoundTrips) {
+    CHECK(RoundTrips({}));
+    CHECK(RoundTrips({ 1, 2, 3 }));
+    CHECK(RoundTrips(std::vector<uint8_t>(100000, 7)));
+    CHECK(RoundTrips(MakeCaptureLikeData(100000)));
+
+    std::vector<uint8_t> noise(4096);
+    std::mt19937 random(7);
+    for (auto& byte : noise) {
+        byte = static_cast<uint8_t>(random());
+    }
+    CHECK(RoundTrips(noise));
+
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> repetitive(100000, 7);
+    CompressBlock(repetitive.data(), repetitive.size(), compressed);
+    CHECK(compressed.size() < 100);
+}
+
+TEST(Compression, RejectsTruncatedInput) {
+    std::vector<uint8_t> data = MakeCaptureLikeData(2000);
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> output;
+    CompressBlock(data.data(), data.size(), compressed);
+
+    // Only dropping the empty literal run that ends a block can still
+    // decode, and then to the same bytes.
+    size_t accepted = 0;
+    for (size_t size = 0; size < compressed.size(); ++size) {
+        if (DecompressBlock(compressed.data(), size, output, data.size())) {
+            ++accepted;
+            CHECK(size == compressed.size() - 1 && output == data);
+        }
+        CHECK(output.size() <= data.size());
+    }
+    CHECK(accepted <= 1);
+    CHECK(!DecompressBlock(compressed.data(), compressed.size() / 2, output, data.size()));
+}
+
+TEST(Compression, RejectsWrongExpectedSize) {
+    std::vector<uint8_t> data = MakeCaptureLikeData(2000);
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> output;
+    CompressBlock(data.data(), data.size(), compressed);
+
+    CHECK(!DecompressBlock(compressed.data(), compressed.size(), output, data.size() + 1));
+    CHECK(!DecompressBlock(compressed.data(), compressed.size(), output, data.size() - 1));
+    CHECK(output.size() < data.size());
+    CHECK(!DecompressBlock(compressed.data(), compressed.size(), output, 0));
+    CHECK(output.empty());
+}
+
+TEST(Compression, RejectsRunsPastExpectedSize) {
+    std::vector<uint8_t> output;
+
+    // 200 literals claimed for a 10-byte block.
+    std::vector<uint8_t> longLiterals = { 0xc8, 0x01 };
+    longLiterals.resize(longLiterals.size() + 200, 'x');
+    CHECK(!DecompressBlock(longLiterals.data(), longLiterals.size(), output, 10));
+    CHECK(output.empty());
+
+    // Four literals, then a match of about 2^56 bytes at offset 4.
+    std::vector<uint8_t> hugeMatch = { 4, 'a', 'b', 'c', 'd',
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 4, 0 };
+    CHECK(!DecompressBlock(hugeMatch.data(), hugeMatch.size(), output, 100));
+    CHECK(output.size() <= 100);
+
+    // A match one byte longer than the space left.
+    std::vector<uint8_t> longMatch = { 4, 'a', 'b', 'c', 'd', 3, 4, 0 };
+    CHECK(!DecompressBlock(longMatch.data(), longMatch.size(), output, 10));
+    CHECK(output.size() <= 10);
+    CHECK(DecompressBlock(longMatch.data(), longMatch.size(), output, 11));
+    CHECK(output == std::vector<uint8_t>({ 'a', 'b', 'c', 'd', 'a', 'b', 'c', 'd', 'a', 'b', 'c' }));
+}
+
+TEST(Compression, RejectsBadOffsets) {
+    std::vector<uint8_t> output;
+    std::vector<uint8_t> zeroOffset = { 4, 'a', 'b', 'c', 'd', 0, 0, 0 };
+    std::vector<uint8_t> farOffset = { 4, 'a', 'b', 'c', 'd', 0, 5, 0 };
+    CHECK(!DecompressBlock(zeroOffset.data(), zeroOffset.size(), output, 8));
+    CHECK(!DecompressBlock(farOffset.data(), farOffset.size(), output, 8));
+
+    // An unterminated varint.
+    std::vector<uint8_t> badVarint(12, 0xff);
+    CHECK(!DecompressBlock(badVarint.data(), badVarint.size(), output, 8));
+}
+
+TEST(Compression, CorruptInputStaysBounded) {
+    std::vector<uint8_t> data = MakeCaptureLikeData(4000);
+    std::vector<uint8_t> compressed;
+    std::vector<uint8_t> output;
+    CompressBlock(data.data(), data.size(), compressed);
+
+    std::mt19937 random(1234);
+    bool bounded = true;
+    for (int trial = 0; trial < 2000; ++trial) {
+        std::vector<uint8_t> corrupt = compressed;
+        for (int flip = 0; flip < 3; ++flip) {
+            corrupt[random() % corrupt.size()] ^= static_cast<uint8_t>(1u << (random() % 8));
+        }
+        bool accepted = DecompressBlock(corrupt.data(), corrupt.size(), output, data.size());
+        bounded = bounded && output.size() <= data.size() && (!accepted || output.size() == data.size());
+    }
+    CHECK(bounded);
+}
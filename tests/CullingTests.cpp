@@ -0,0 +1,116 @@
+#include "Test.h"
+#include "Culling.h"
+#include "Parallel.h"
+#include <cmath>
+#include <vector>
+
+namespace {
+    constexpr float Pi = 3.14159265358979323846f;
+    constexpr float Epsilon = 1e-4f;
+
+    bool Near(float a, float b) {
+        return std::fabs(a - b) < Epsilon;
+    }
+
+    bool Near(const Plane& plane, const Float3& normal, float distance) {
+        return Near(plane.normal.x, normal.x) && Near(plane.normal.y, normal.y) &&
+            Near(plane.normal.z, normal.z) && Near(plane.distance, distance);
+    }
+
+    // Camera at the origin looking down +Z with a 90 degree field of view
+    // both ways, so the side planes are x = +-z and y = +-z.
+    Frustum MakeTestFrustum() {
+        Float4x4 view = MakeLookAtLH({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f });
+        Float4x4 projection = MakePerspectiveFovLH(Pi / 2.0f, 1.0f, 1.0f, 100.0f);
+        return ExtractFrustum(Multiply(view, projection));
+    }
+
+    struct SphereCase {
+        BoundingSphere sphere;
+        bool visible;
+    };
+
+    // For every plane: one sphere just outside, one straddling it by half
+    // its radius.
+    const SphereCase SphereCases[] = {
+        { { { 0.0f, 0.0f, 50.0f }, 1.0f }, true },
+        { { { -60.0f, 0.0f, 50.0f }, 1.0f }, false },   // left
+        { { { -50.5f, 0.0f, 50.0f }, 1.0f }, true },
+        { { { 60.0f, 0.0f, 50.0f }, 1.0f }, false },    // right
+        { { { 50.5f, 0.0f, 50.0f }, 1.0f }, true },
+        { { { 0.0f, -60.0f, 50.0f }, 1.0f }, false },   // bottom
+        { { { 0.0f, -50.5f, 50.0f }, 1.0f }, true },
+        { { { 0.0f, 60.0f, 50.0f }, 1.0f }, false },    // top
+        { { { 0.0f, 50.5f, 50.0f }, 1.0f }, true },
+        { { { 0.0f, 0.0f, -5.0f }, 1.0f }, false },     // near
+        { { { 0.0f, 0.0f, 0.5f }, 1.0f }, true },
+        { { { 0.0f, 0.0f, 110.0f }, 1.0f }, false },    // far
+        { { { 0.0f, 0.0f, 100.5f }, 1.0f }, true },
+    };
+}
+
+TEST(Culling, ExtractsNormalizedInwardPlanes) {
+    Frustum frustum = MakeTestFrustum();
+    float diagonal = 1.0f / std::sqrt(2.0f);
+
+    CHECK(Near(frustum.planes[0], { diagonal, 0.0f, diagonal }, 0.0f));
+    CHECK(Near(frustum.planes[1], { -diagonal, 0.0f, diagonal }, 0.0f));
+    CHECK(Near(frustum.planes[2], { 0.0f, diagonal, diagonal }, 0.0f));
+    CHECK(Near(frustum.planes[3], { 0.0f, -diagonal, diagonal }, 0.0f));
+    CHECK(Near(frustum.planes[4], { 0.0f, 0.0f, 1.0f }, -1.0f));
+    // w - z cancels badly at the far plane, so its distance is only close.
+    const Plane& far = frustum.planes[5];
+    CHECK(Near(far.normal.x, 0.0f) && Near(far.normal.y, 0.0f) && Near(far.normal.z, -1.0f));
+    CHECK(std::fabs(far.distance - 100.0f) < 0.05f);
+}
+
+TEST(Culling, SpheresAgainstEachPlane) {
+    Frustum frustum = MakeTestFrustum();
+    constexpr uint32_t count = sizeof(SphereCases) / sizeof(SphereCases[0]);
+
+    std::vector<BoundingSphere> spheres;
+    uint32_t expectedVisible = 0;
+    for (const SphereCase& sphereCase : SphereCases) {
+        spheres.push_back(sphereCase.sphere);
+        expectedVisible += sphereCase.visible ? 1 : 0;
+    }
+
+    std::vector<uint8_t> visibility(count, 0xff);
+    CHECK_EQ(CullSpheres(frustum, spheres.data(), count, visibility.data()), expectedVisible);
+    for (uint32_t i = 0; i < count; ++i) {
+        CHECK_EQ(visibility[i], SphereCases[i].visible ? 1 : 0);
+        CHECK_EQ(IsSphereVisible(frustum, spheres[i]), SphereCases[i].visible);
+    }
+}
+
+TEST(Culling, FollowsTheCamera) {
+    // Looking down -X from +X: the origin is in view, a point behind the
+    // camera is not.
+    Float4x4 view = MakeLookAtLH({ 5.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+    Frustum frustum = ExtractFrustum(Multiply(view, MakePerspectiveFovLH(Pi / 3.0f, 16.0f / 9.0f, 0.1f, 50.0f)));
+
+    CHECK(IsSphereVisible(frustum, { { 0.0f, 0.0f, 0.0f }, 0.5f }));
+    CHECK(!IsSphereVisible(frustum, { { 10.0f, 0.0f, 0.0f }, 0.5f }));
+    CHECK(!IsSphereVisible(frustum, { { -60.0f, 0.0f, 0.0f }, 0.5f }));
+    CHECK(!IsSphereVisible(frustum, { { 0.0f, 0.0f, 20.0f }, 0.5f }));
+}
+
+TEST(Culling, ParallelCullingCountsEverySphere) {
+    Frustum frustum = MakeTestFrustum();
+    constexpr uint32_t count = 20000;
+    std::vector<BoundingSphere> spheres(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        spheres[i] = i % 3 == 0 ? BoundingSphere{ { 0.0f, 0.0f, 50.0f }, 1.0f }
+                                : BoundingSphere{ { 0.0f, 0.0f, -50.0f }, 1.0f };
+    }
+
+    SetWorkerCount(4);
+    std::vector<uint8_t> visibility(count, 0xff);
+    uint32_t visible = CullSpheres(frustum, spheres.data(), count, visibility.data());
+    SetWorkerCount(0);
+
+    CHECK_EQ(visible, (count + 2) / 3);
+    for (uint32_t i = 0; i < count; ++i) {
+        CHECK_EQ(visibility[i], i % 3 == 0 ? 1 : 0);
+    }
+}
@@ -0,0 +1,89 @@
+#include "Test.h"
+#include "DependencyTracker.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace {
+    size_t IndexOf(const std::vector<std::string>& targets, const std::string& target) {
+        return static_cast<size_t>(std::find(targets.begin(), targets.end(), target) - targets.begin());
+    }
+
+    // Mirrors the renderer: each shader depends on its source and includes,
+    // the pipeline depends on both shaders.
+    DependencyTracker MakeShaderGraph() {
+        DependencyTracker tracker;
+        tracker.SetDependencies("shader:BasicVS", { "shaders/BasicVS.hlsl", "shaders/Common.hlsli" });
+        tracker.SetDependencies("shader:BasicPS", { "shaders/BasicPS.hlsl", "shaders/Common.hlsli",
+            "shaders/Lighting.hlsli" });
+        tracker.SetDependencies("pipeline:Basic", { "shader:BasicVS", "shader:BasicPS" });
+        return tracker;
+    }
+}
+
+TEST(DependencyTracker, SharedIncludeInvalidatesShadersBeforePipeline) {
+    DependencyTracker tracker = MakeShaderGraph();
+    std::vector<std::string> affected = tracker.GetAffectedTargets({ "shaders/Common.hlsli" });
+
+    CHECK_EQ(affected.size(), 3u);
+    CHECK(IndexOf(affected, "shader:BasicVS") < IndexOf(affected, "pipeline:Basic"));
+    CHECK(IndexOf(affected, "shader:BasicPS") < IndexOf(affected, "pipeline:Basic"));
+    CHECK_EQ(affected.back(), "pipeline:Basic");
+}
+
+TEST(DependencyTracker, SourceChangeOnlyReachesItsChain) {
+    DependencyTracker tracker = MakeShaderGraph();
+
+    std::vector<std::string> affected = tracker.GetAffectedTargets({ "shaders/Lighting.hlsli" });
+    CHECK(affected == std::vector<std::string>({ "shader:BasicPS", "pipeline:Basic" }));
+
+    affected = tracker.GetAffectedTargets({ "shaders/BasicVS.hlsl" });
+    CHECK(affected == std::vector<std::string>({ "shader:BasicVS", "pipeline:Basic" }));
+
+    CHECK(tracker.GetAffectedTargets({ "shaders/Unused.hlsli" }).empty());
+    CHECK(tracker.GetAffectedTargets({}).empty());
+}
+
+TEST(DependencyTracker, LongChainsAreOrderedByDependency) {
+    DependencyTracker tracker;
+    // Declared out of order so the result cannot just follow insertion.
+    tracker.SetDependencies("d", { "c" });
+    tracker.SetDependencies("b", { "a.txt" });
+    tracker.SetDependencies("c", { "b", "a.txt" });
+    tracker.SetDependencies("e", { "d", "b" });
+
+    std::vector<std::string> affected = tracker.GetAffectedTargets({ "a.txt" });
+    CHECK(affected == std::vector<std::string>({ "b", "c", "d", "e" }));
+
+    affected = tracker.GetAffectedTargets({ "c" });
+    CHECK(affected == std::vector<std::string>({ "d", "e" }));
+}
+
+TEST(DependencyTracker, SetDependenciesReplacesInputs) {
+    DependencyTracker tracker = MakeShaderGraph();
+    // A recompile found that BasicVS no longer includes Common.hlsli.
+    tracker.SetDependencies("shader:BasicVS", { "shaders/BasicVS.hlsl" });
+
+    std::vector<std::string> affected = tracker.GetAffectedTargets({ "shaders/Common.hlsli" });
+    CHECK(affected == std::vector<std::string>({ "shader:BasicPS", "pipeline:Basic" }));
+    CHECK(tracker.GetDependencies("shader:BasicVS") == std::vector<std::string>({ "shaders/BasicVS.hlsl" }));
+}
+
+TEST(DependencyTracker, RemovedTargetsStopPropagating) {
+    DependencyTracker tracker = MakeShaderGraph();
+    tracker.RemoveTarget("shader:BasicPS");
+
+    CHECK(!tracker.HasTarget("shader:BasicPS"));
+    CHECK(tracker.HasTarget("pipeline:Basic"));
+    CHECK(tracker.GetAffectedTargets({ "shaders/Lighting.hlsli" }).empty());
+    CHECK(tracker.GetDependencies("shader:BasicPS").empty());
+
+    tracker.RemoveTarget("missing");
+    CHECK_EQ(tracker.GetAffectedTargets({ "shaders/Common.hlsli" }).size(), 2u);
+}
+
+TEST(DependencyTracker, NormalizesPaths) {
+    CHECK_EQ(NormalizePath("assets/./shaders/../shaders/BasicVS.hlsl"), "assets/shaders/BasicVS.hlsl");
+    CHECK_EQ(NormalizePath("assets/shaders/"), "assets/shaders");
+    CHECK_EQ(NormalizePath("/"), "/");
+}
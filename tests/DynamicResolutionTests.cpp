@@ -0,0 +1,174 @@
+#include "Test.h"
+#include "DynamicResolution.h"
+#include <cmath>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace {
+    constexpr float Epsilon = 1e-5f;
+
+    // GPU model used by the controller: cost scales with pixel count.
+    struct Trace {
+        std::vector<float> scales;
+        std::vector<float> frameTimes;
+        bool withinBounds = true;
+        bool rateLimited = true;
+    };
+
+    // Feeds the controller the time each frame would take at the scale it
+    // chose for that frame. fullResolutionCost(frame) gives the cost at scale 1.
+    Trace Run(DynamicResolutionController& controller, int frames,
+        const std::function<float(int frame)>& fullResolutionCost) {
+        const DynamicResolutionSettings& settings = controller.GetSettings();
+        Trace trace;
+        float scale = controller.GetScale();
+
+        for (int frame = 0; frame < frames; ++frame) {
+            float frameTime = fullResolutionCost(frame) * scale * scale;
+            bool panic = frameTime > settings.targetFrameTimeMs * settings.panicRatio;
+            float next = controller.Update(frameTime);
+
+            trace.withinBounds = trace.withinBounds &&
+                next >= settings.minScale - Epsilon && next <= settings.maxScale + Epsilon;
+            trace.rateLimited = trace.rateLimited && next - scale <= settings.maxStepUp + Epsilon &&
+                (panic || scale - next <= settings.maxStepDown + Epsilon);
+
+            trace.frameTimes.push_back(frameTime);
+            trace.scales.push_back(next);
+            scale = next;
+        }
+        return trace;
+    }
+
+    float Budget(const DynamicResolutionSettings& settings) {
+        return settings.targetFrameTimeMs * settings.headroom;
+    }
+}
+
+TEST(DynamicResolution, SteadyOverloadConvergesToBudget) {
+    DynamicResolutionController controller;
+    const DynamicResolutionSettings& settings = controller.GetSettings();
+
+    // 20 ms at full resolution: over target but below the panic threshold.
+    Trace trace = Run(controller, 300, [](int) { return 20.0f; });
+    CHECK(trace.withinBounds);
+    CHECK(trace.rateLimited);
+
+    float expected = std::sqrt(Budget(settings) / 20.0f);
+    CHECK(std::fabs(trace.scales.back() - expected) <= settings.deadband + Epsilon);
+    CHECK(trace.frameTimes.back() <= settings.targetFrameTimeMs);
+    CHECK(std::fabs(trace.frameTimes.back() - Budget(settings)) < Budget(settings) * 0.1f);
+
+    // Once converged the scale holds still.
+    float settled = trace.scales[200];
+    bool steady = true;
+    for (size_t i = 200; i < trace.scales.size(); ++i) {
+        steady = steady && trace.scales[i] == settled;
+    }
+    CHECK(steady);
+}
+
+TEST(DynamicResolution, PanicDropsImmediately) {
+    DynamicResolutionController controller;
+    const DynamicResolutionSettings& settings = controller.GetSettings();
+
+    float scale = controller.Update(40.0f);
+    CHECK(std::fabs(scale - std::sqrt(Budget(settings) / 40.0f)) < 1e-3f);
+
+    Trace trace = Run(controller, 200, [](int) { return 40.0f; });
+    CHECK(trace.withinBounds);
+    CHECK(trace.rateLimited);
+    CHECK(trace.frameTimes.back() <= settings.targetFrameTimeMs);
+}
+
+TEST(DynamicResolution, ClampsToScaleBounds) {
+    DynamicResolutionController heavy;
+    Trace overload = Run(heavy, 200, [](int) { return 200.0f; });
+    CHECK(overload.withinBounds);
+    CHECK_EQ(overload.scales.back(), heavy.GetSettings().minScale);
+
+    DynamicResolutionController light;
+    Trace underload = Run(light, 200, [](int) { return 5.0f; });
+    CHECK(underload.withinBounds);
+    for (float scale : underload.scales) {
+        CHECK_EQ(scale, light.GetSettings().maxScale);
+    }
+
+    DynamicResolutionSettings narrow;
+    narrow.minScale = 0.7f;
+    narrow.maxScale = 0.9f;
+    DynamicResolutionController bounded(narrow);
+    CHECK_EQ(bounded.GetScale(), 0.9f);
+    Trace narrowTrace = Run(bounded, 200, [](int frame) { return frame < 100 ? 200.0f : 1.0f; });
+    CHECK(narrowTrace.withinBounds);
+    CHECK_EQ(narrowTrace.scales[99], 0.7f);
+    CHECK_EQ(narrowTrace.scales.back(), 0.9f);
+}
+
+TEST(DynamicResolution, RecoversAfterLoadDrops) {
+    DynamicResolutionController controller;
+    const DynamicResolutionSettings& settings = controller.GetSettings();
+
+    Trace trace = Run(controller, 400, [](int frame) { return frame < 100 ? 30.0f : 8.0f; });
+    CHECK(trace.withinBounds);
+    CHECK(trace.rateLimited);
+    CHECK(trace.scales[99] < 0.8f);
+    // Climbing back is limited to maxStepUp per frame.
+    CHECK(trace.scales[110] <= trace.scales[99] + 11 * settings.maxStepUp + Epsilon);
+    CHECK_EQ(trace.scales.back(), settings.maxScale);
+}
+
+TEST(DynamicResolution, OneOffSpikesRecover) {
+    DynamicResolutionController controller;
+    const DynamicResolutionSettings& settings = controller.GetSettings();
+
+    // Comfortably under budget with a 3x spike every 100 frames.
+    Trace trace = Run(controller, 500, [](int frame) { return frame % 100 == 50 ? 30.0f : 10.0f; });
+    CHECK(trace.withinBounds);
+    CHECK(trace.rateLimited);
+    CHECK(trace.scales[50] < settings.maxScale);
+    CHECK_EQ(trace.scales[99], settings.maxScale);
+    CHECK_EQ(trace.scales.back(), settings.maxScale);
+
+    float lowest = settings.maxScale;
+    for (float scale : trace.scales) {
+        lowest = std::fmin(lowest, scale);
+    }
+    CHECK(lowest >= std::sqrt(Budget(settings) / 30.0f) - Epsilon);
+}
+
+TEST(DynamicResolution, IgnoresNoiseInsideDeadband) {
+    DynamicResolutionController controller;
+    const DynamicResolutionSettings& settings = controller.GetSettings();
+
+    Trace warmup = Run(controller, 300, [](int) { return 20.0f; });
+    float settled = warmup.scales.back();
+
+    // +-1% jitter around the same load moves the ideal scale by well under
+    // the deadband.
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> jitter(-0.01f, 0.01f);
+    Trace noisy = Run(controller, 500, [&](int) { return 20.0f * (1.0f + jitter(random)); });
+    CHECK(noisy.withinBounds);
+    bool unchanged = true;
+    for (float scale : noisy.scales) {
+        unchanged = unchanged && scale == settled;
+    }
+    CHECK(unchanged);
+    CHECK(settings.deadband > 0.0f);
+}
+
+TEST(DynamicResolution, IgnoresInvalidSamplesAndResets) {
+    DynamicResolutionController controller;
+    controller.Update(40.0f);
+    float scale = controller.GetScale();
+
+    CHECK_EQ(controller.Update(0.0f), scale);
+    CHECK_EQ(controller.Update(-5.0f), scale);
+    CHECK_EQ(controller.Update(std::nanf("")), scale);
+
+    controller.Reset();
+    CHECK_EQ(controller.GetScale(), controller.GetSettings().maxScale);
+    CHECK_EQ(controller.GetSmoothedFrameTime(), 0.0f);
+}
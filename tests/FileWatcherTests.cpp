@@ -0,0 +1,101 @@
+#include "Test.h"
+#include "DependencyTracker.h"
+#include "FileWatcher.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+    void WriteFile(const std::filesystem::path& path, const std::string& contents) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file << contents;
+    }
+
+    bool Contains(const std::vector<std::string>& files, const std::filesystem::path& path) {
+        return std::find(files.begin(), files.end(), NormalizePath(path.string())) != files.end();
+    }
+}
+
+TEST(FileWatcher, ReportsClosedWrites) {
+    std::filesystem::path directory = MakeTestDirectory("watch_write");
+    FileWatcher watcher;
+    CHECK(watcher.Watch(directory.string()));
+
+    std::vector<std::string> changed;
+    watcher.Poll(changed);
+    CHECK(changed.empty());
+
+    WriteFile(directory / "BasicVS.hlsl", "float4 main() : SV_Position { return 0; }");
+    watcher.Poll(changed);
+    CHECK_EQ(changed.size(), 1u);
+    CHECK(Contains(changed, directory / "BasicVS.hlsl"));
+
+    // Events are consumed by Poll.
+    changed.clear();
+    watcher.Poll(changed);
+    CHECK(changed.empty());
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FileWatcher, IgnoresWritesStillInProgress) {
+    std::filesystem::path directory = MakeTestDirectory("watch_partial");
+    FileWatcher watcher;
+    CHECK(watcher.Watch(directory.string()));
+
+    std::vector<std::string> changed;
+    {
+        std::ofstream file(directory / "Common.hlsli", std::ios::binary);
+        file << "#define HALF";
+        file.flush();
+        watcher.Poll(changed);
+        CHECK(changed.empty());
+    }
+
+    watcher.Poll(changed);
+    CHECK(Contains(changed, directory / "Common.hlsli"));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FileWatcher, ReportsRewriteRenamedIntoPlace) {
+    std::filesystem::path directory = MakeTestDirectory("watch_rename");
+    std::filesystem::path staging = MakeTestDirectory("watch_rename_staging");
+    WriteFile(directory / "BasicPS.hlsl", "old");
+
+    FileWatcher watcher;
+    CHECK(watcher.Watch(directory.string()));
+
+    // Editors that save atomically write a temporary file, then rename it
+    // over the original.
+    WriteFile(directory / "BasicPS.hlsl.tmp", "new");
+    std::filesystem::rename(directory / "BasicPS.hlsl.tmp", directory / "BasicPS.hlsl");
+
+    std::vector<std::string> changed;
+    watcher.Poll(changed);
+    CHECK(Contains(changed, directory / "BasicPS.hlsl"));
+
+    // A file written elsewhere and moved in only produces the rename.
+    WriteFile(staging / "UpscalePS.hlsl", "moved");
+    std::filesystem::rename(staging / "UpscalePS.hlsl", directory / "UpscalePS.hlsl");
+
+    changed.clear();
+    watcher.Poll(changed);
+    CHECK_EQ(changed.size(), 1u);
+    CHECK(Contains(changed, directory / "UpscalePS.hlsl"));
+
+    watcher.Shutdown();
+    changed.clear();
+    watcher.Poll(changed);
+    CHECK(changed.empty());
+
+    std::filesystem::remove_all(directory);
+    std::filesystem::remove_all(staging);
+}
+
+TEST(FileWatcher, RejectsMissingDirectory) {
+    FileWatcher watcher;
+    CHECK(!watcher.Watch((std::filesystem::temp_directory_path() / "engine_tests_missing_dir").string()));
+}
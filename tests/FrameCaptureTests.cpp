@@ -0,0 +1,168 @@
+#include "Test.h"
+#include "FrameCapture.h"
+#include "NullBackend.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+    const uint32_t CubeIndices[] = { 0, 1, 2, 0, 2, 3 };
+
+    void RecordFrame(ICommandBackend& backend, uint64_t frameIndex) {
+        backend.BeginFrame(frameIndex);
+        if (frameIndex == 0) {
+            backend.CreateBuffer({ 0, BufferUsage::Vertex, 4 * 28, 0x1000, 28, 0 });
+            backend.CreateBuffer({ 1, BufferUsage::Index, sizeof(CubeIndices), 0x2000, 0, 42 });
+            backend.UploadBuffer(1, 0, CubeIndices, sizeof(CubeIndices));
+        }
+        backend.SetPipeline(1);
+        backend.Clear({ { 0.2f, 0.2f, 0.3f, 1.0f }, 1.0f });
+        for (int i = 0; i < 10; ++i) {
+            backend.DrawIndexed({ 6, 1, 0, 0, 0 });
+        }
+        backend.EndFrame();
+    }
+
+    std::filesystem::path WriteCapture(const std::filesystem::path& directory, uint64_t frames) {
+        std::filesystem::path path = directory / "test.gcap";
+        CaptureWriter writer;
+        CHECK(writer.Open(path.string()));
+        for (uint64_t frame = 0; frame < frames; ++frame) {
+            RecordFrame(writer, frame);
+        }
+        writer.Close();
+        CHECK_EQ(writer.GetFramesWritten(), frames);
+        return path;
+    }
+
+    std::vector<char> ReadBytes(const std::filesystem::path& path) {
+        std::ifstream file(path, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    void WriteBytes(const std::filesystem::path& path, const std::vector<char>& bytes) {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(bytes.data(), bytes.size());
+    }
+
+    uint32_t CountFrames(const std::filesystem::path& path) {
+        CaptureReader reader;
+        if (!reader.Open(path.string())) {
+            return 0;
+        }
+        uint32_t frames = 0;
+        std::vector<uint8_t> frame;
+        while (reader.ReadFrame(frame)) {
+            ++frames;
+        }
+        return frames;
+    }
+}
+
+TEST(FrameCapture, RoundTripsThroughReplay) {
+    std::filesystem::path directory = MakeTestDirectory("capture_roundtrip");
+    std::filesystem::path path = WriteCapture(directory, 3);
+
+    NullBackend direct;
+    for (uint64_t frame = 0; frame < 3; ++frame) {
+        RecordFrame(direct, frame);
+    }
+
+    CaptureReader reader;
+    CHECK(reader.Open(path.string()));
+    NullBackend replayed;
+    ReplayStats stats;
+    std::vector<uint8_t> frame;
+    while (reader.ReadFrame(frame)) {
+        CHECK(ReplayFrame(frame.data(), frame.size(), replayed, &stats));
+    }
+
+    CHECK_EQ(stats.frames, 3u);
+    CHECK_EQ(replayed.GetCounters().frames, direct.GetCounters().frames);
+    CHECK_EQ(replayed.GetCounters().drawCalls, 30u);
+    CHECK_EQ(replayed.GetCounters().indices, direct.GetCounters().indices);
+    CHECK_EQ(replayed.GetCounters().bytesUploaded, sizeof(CubeIndices));
+    CHECK_EQ(replayed.GetCounters().invalidCommands, 0u);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FrameCapture, StopsAtTruncatedFrame) {
+    std::filesystem::path directory = MakeTestDirectory("capture_truncated");
+    std::filesystem::path path = WriteCapture(directory, 3);
+    std::vector<char> bytes = ReadBytes(path);
+    CHECK_EQ(CountFrames(path), 3u);
+
+    // Cutting anywhere inside the last frame leaves two readable frames.
+    bytes.pop_back();
+    WriteBytes(path, bytes);
+    CHECK_EQ(CountFrames(path), 2u);
+
+    bytes.resize(8 + 3);
+    WriteBytes(path, bytes);
+    CHECK_EQ(CountFrames(path), 0u);
+
+    bytes.resize(6);
+    WriteBytes(path, bytes);
+    CaptureReader reader;
+    CHECK(!reader.Open(path.string()));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FrameCapture, RejectsCorruptFrameSizes) {
+    std::filesystem::path directory = MakeTestDirectory("capture_sizes");
+    std::filesystem::path path = WriteCapture(directory, 1);
+    std::vector<char> original = ReadBytes(path);
+    const size_t rawSizeOffset = 8;
+    const size_t compressedSizeOffset = 12;
+
+    std::vector<char> bytes = original;
+    uint32_t hugeRawSize = MaxCaptureFrameSize + 1;
+    std::memcpy(bytes.data() + rawSizeOffset, &hugeRawSize, sizeof(hugeRawSize));
+    WriteBytes(path, bytes);
+    CHECK_EQ(CountFrames(path), 0u);
+
+    bytes = original;
+    uint32_t hugeCompressedSize = 0xffffffffu;
+    std::memcpy(bytes.data() + compressedSizeOffset, &hugeCompressedSize, sizeof(hugeCompressedSize));
+    WriteBytes(path, bytes);
+    CHECK_EQ(CountFrames(path), 0u);
+
+    bytes = original;
+    uint32_t rawSize = 0;
+    std::memcpy(&rawSize, bytes.data() + rawSizeOffset, sizeof(rawSize));
+    ++rawSize;
+    std::memcpy(bytes.data() + rawSizeOffset, &rawSize, sizeof(rawSize));
+    WriteBytes(path, bytes);
+    CHECK_EQ(CountFrames(path), 0u);
+
+    bytes = original;
+    bytes[0] ^= 1;
+    WriteBytes(path, bytes);
+    CaptureReader reader;
+    CHECK(!reader.Open(path.string()));
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST(FrameCapture, ReplayRejectsTruncatedCommands) {
+    std::vector<uint8_t> frame;
+    {
+        std::filesystem::path directory = MakeTestDirectory("capture_commands");
+        std::filesystem::path path = WriteCapture(directory, 1);
+        CaptureReader reader;
+        CHECK(reader.Open(path.string()));
+        CHECK(reader.ReadFrame(frame));
+        std::filesystem::remove_all(directory);
+    }
+
+    NullBackend backend;
+    CHECK(ReplayFrame(frame.data(), frame.size(), backend, nullptr));
+    for (size_t cut = 1; cut < 64; ++cut) {
+        NullBackend partial;
+        CHECK(!ReplayFrame(frame.data(), frame.size() - cut, partial, nullptr) ||
+            partial.GetCounters().frames == 0);
+    }
+}
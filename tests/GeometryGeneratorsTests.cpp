@@ -0,0 +1,189 @@
+#include "Test.h"
+#include "GeometryGenerators.h"
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace {
+    constexpr uint32_t BaseVertex = 7;
+    constexpr uint32_t UnwrittenIndex = UINT32_MAX;
+    constexpr float UnwrittenPosition = 1e30f;
+    constexpr Float4 White = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+    struct Generated {
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;
+        GeometryCounts counts;
+    };
+
+    // Runs a generator into buffers one element larger than the reported
+    // counts, pre-filled with markers, and checks it wrote exactly the
+    // reported ranges.
+    template <typename Desc>
+    Generated Generate(bool (*generate)(const Desc&, Vertex*, uint32_t*, uint32_t),
+        const Desc& desc, GeometryCounts counts) {
+        Generated mesh;
+        mesh.counts = counts;
+        mesh.vertices.assign(counts.vertexCount + 1, Vertex{ { UnwrittenPosition, 0.0f, 0.0f }, White });
+        mesh.indices.assign(counts.indexCount + 1, UnwrittenIndex);
+        CHECK(generate(desc, mesh.vertices.data(), mesh.indices.data(), BaseVertex));
+
+        CHECK_EQ(mesh.vertices.back().position.x, UnwrittenPosition);
+        CHECK_EQ(mesh.indices.back(), UnwrittenIndex);
+        mesh.vertices.pop_back();
+        mesh.indices.pop_back();
+        for (const Vertex& vertex : mesh.vertices) {
+            CHECK(vertex.position.x != UnwrittenPosition);
+            CHECK(std::isfinite(vertex.position.x) && std::isfinite(vertex.position.y) &&
+                std::isfinite(vertex.position.z));
+        }
+        return mesh;
+    }
+
+    void CheckIndicesInRange(const Generated& mesh) {
+        CHECK_EQ(mesh.indices.size() % 3, 0u);
+        for (uint32_t index : mesh.indices) {
+            CHECK(index >= BaseVertex && index - BaseVertex < mesh.counts.vertexCount);
+        }
+    }
+
+    Float3 Subtract(const Float3& a, const Float3& b) {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    Float3 Cross(const Float3& a, const Float3& b) {
+        return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x };
+    }
+
+    float Dot(const Float3& a, const Float3& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
+
+    // Clockwise seen from outside in a left-handed space means the cross
+    // product of the first two edges points outward. outward maps a
+    // triangle's centroid to the outward direction there. Degenerate
+    // triangles (sphere poles) are skipped; returns how many were checked.
+    size_t CheckClockwiseFromOutside(const Vertex* vertices, const uint32_t* indices, size_t indexCount,
+        uint32_t baseVertex, const std::function<Float3(const Float3&)>& outward) {
+        size_t checked = 0;
+        for (size_t i = 0; i < indexCount; i += 3) {
+            const Float3& a = vertices[indices[i + 0] - baseVertex].position;
+            const Float3& b = vertices[indices[i + 1] - baseVertex].position;
+            const Float3& c = vertices[indices[i + 2] - baseVertex].position;
+            Float3 normal = Cross(Subtract(b, a), Subtract(c, a));
+            if (Dot(normal, normal) < 1e-12f) {
+                continue;
+            }
+
+            Float3 centroid = { (a.x + b.x + c.x) / 3.0f, (a.y + b.y + c.y) / 3.0f, (a.z + b.z + c.z) / 3.0f };
+            CHECK(Dot(normal, outward(centroid)) > 0.0f);
+            ++checked;
+        }
+        return checked;
+    }
+
+    size_t CheckClockwiseFromOutside(const Generated& mesh, const std::function<Float3(const Float3&)>& outward) {
+        return CheckClockwiseFromOutside(mesh.vertices.data(), mesh.indices.data(), mesh.indices.size(),
+            BaseVertex, outward);
+    }
+
+    Float3 AwayFromOrigin(const Float3& point) {
+        return point;
+    }
+}
+
+TEST(GeometryGenerators, SphereMatchesCountsAndWinding) {
+    SphereDesc desc = { 1.0f, 12, 6, White };
+    Generated mesh = Generate(GenerateSphere, desc, GetSphereCounts(desc.slices, desc.stacks));
+    CheckIndicesInRange(mesh);
+    // One triangle per pole quad collapses onto the pole.
+    CHECK_EQ(CheckClockwiseFromOutside(mesh, AwayFromOrigin), mesh.indices.size() / 3 - 2 * desc.slices);
+}
+
+TEST(GeometryGenerators, CylinderMatchesCountsAndWinding) {
+    CylinderDesc desc = { 0.5f, 2.0f, 10, 3, White };
+    Generated mesh = Generate(GenerateCylinder, desc, GetCylinderCounts(desc.slices, desc.stacks));
+    CheckIndicesInRange(mesh);
+    // Side normals are horizontal and cap normals vertical, so the centroid
+    // points outward for both.
+    CHECK_EQ(CheckClockwiseFromOutside(mesh, AwayFromOrigin), mesh.indices.size() / 3);
+}
+
+TEST(GeometryGenerators, TorusMatchesCountsAndWinding) {
+    TorusDesc desc = { 1.0f, 0.25f, 16, 8, White };
+    Generated mesh = Generate(GenerateTorus, desc, GetTorusCounts(desc.majorSegments, desc.minorSegments));
+    CheckIndicesInRange(mesh);
+    CHECK_EQ(CheckClockwiseFromOutside(mesh, [&desc](const Float3& point) {
+        float length = std::sqrt(point.x * point.x + point.z * point.z);
+        Float3 ring = { point.x / length * desc.majorRadius, 0.0f, point.z / length * desc.majorRadius };
+        return Subtract(point, ring);
+    }), mesh.indices.size() / 3);
+}
+
+TEST(GeometryGenerators, PlaneGridMatchesCountsAndFacesUp) {
+    PlaneGridDesc desc = { 4.0f, 2.0f, 5, 3, White };
+    Generated mesh = Generate(GeneratePlaneGrid, desc, GetPlaneGridCounts(desc.columns, desc.rows));
+    CheckIndicesInRange(mesh);
+    CHECK_EQ(CheckClockwiseFromOutside(mesh, [](const Float3&) { return Float3{ 0.0f, 1.0f, 0.0f }; }),
+        mesh.indices.size() / 3);
+}
+
+TEST(GeometryGenerators, SubdividedCubeMatchesCountsAndWinding) {
+    SubdividedCubeDesc desc = { 2.0f, 3 };
+    Generated mesh = Generate(GenerateSubdividedCube, desc, GetSubdividedCubeCounts(desc.subdivisions));
+    CheckIndicesInRange(mesh);
+    CHECK_EQ(CheckClockwiseFromOutside(mesh, AwayFromOrigin), mesh.indices.size() / 3);
+}
+
+TEST(GeometryGenerators, StaticMeshesWindClockwise) {
+    CHECK_EQ(CheckClockwiseFromOutside(UnitCube.vertices.data(), UnitCube.indices.data(),
+        UnitCube.indices.size(), 0, AwayFromOrigin), UnitCube.indices.size() / 3);
+    CHECK_EQ(CheckClockwiseFromOutside(UnitPyramid.vertices.data(), UnitPyramid.indices.data(),
+        UnitPyramid.indices.size(), 0, AwayFromOrigin), UnitPyramid.indices.size() / 3);
+
+    constexpr auto grid = MakePlaneGrid<4, 2>(4.0f, 2.0f, White);
+    CHECK_EQ(CheckClockwiseFromOutside(grid.vertices.data(), grid.indices.data(), grid.indices.size(), 0,
+        [](const Float3&) { return Float3{ 0.0f, 1.0f, 0.0f }; }), grid.indices.size() / 3);
+}
+
+TEST(GeometryGenerators, StaticCubeMatchesRuntimeCube) {
+    constexpr auto cube = MakeSubdividedCube<3>(2.0f);
+    MeshData runtime = CreateSubdividedCube({ 2.0f, 3 });
+    CHECK_EQ(runtime.vertices.size(), cube.vertices.size());
+    CHECK_EQ(runtime.indices.size(), cube.indices.size());
+    if (runtime.vertices.size() != cube.vertices.size() || runtime.indices.size() != cube.indices.size()) {
+        return;
+    }
+
+    for (size_t i = 0; i < cube.vertices.size(); ++i) {
+        const Vertex& a = cube.vertices[i];
+        const Vertex& b = runtime.vertices[i];
+        CHECK(std::fabs(a.position.x - b.position.x) < 1e-6f);
+        CHECK(std::fabs(a.position.y - b.position.y) < 1e-6f);
+        CHECK(std::fabs(a.position.z - b.position.z) < 1e-6f);
+        CHECK(a.color.x == b.color.x && a.color.y == b.color.y && a.color.z == b.color.z && a.color.w == b.color.w);
+    }
+    for (size_t i = 0; i < cube.indices.size(); ++i) {
+        CHECK_EQ(runtime.indices[i], cube.indices[i]);
+    }
+}
+
+TEST(GeometryGenerators, RejectsZeroDivisions) {
+    Vertex vertex = { { UnwrittenPosition, 0.0f, 0.0f }, White };
+    uint32_t index = UnwrittenIndex;
+
+    CHECK(!GenerateSphere({ 1.0f, 0, 4, White }, &vertex, &index));
+    CHECK(!GenerateSphere({ 1.0f, 4, 0, White }, &vertex, &index));
+    CHECK(!GenerateCylinder({ 1.0f, 1.0f, 0, 1, White }, &vertex, &index));
+    CHECK(!GenerateCylinder({ 1.0f, 1.0f, 4, 0, White }, &vertex, &index));
+    CHECK(!GenerateTorus({ 1.0f, 0.5f, 0, 4, White }, &vertex, &index));
+    CHECK(!GenerateTorus({ 1.0f, 0.5f, 4, 0, White }, &vertex, &index));
+    CHECK(!GeneratePlaneGrid({ 1.0f, 1.0f, 0, 1, White }, &vertex, &index));
+    CHECK(!GeneratePlaneGrid({ 1.0f, 1.0f, 1, 0, White }, &vertex, &index));
+    CHECK(!GenerateSubdividedCube({ 1.0f, 0 }, &vertex, &index));
+    CHECK_EQ(vertex.position.x, UnwrittenPosition);
+    CHECK_EQ(index, UnwrittenIndex);
+
+    CHECK(CreateSphere({ 1.0f, 0, 0, White }).IsEmpty());
+    CHECK(CreateSubdividedCube({ 1.0f, 0 }).IsEmpty());
+}
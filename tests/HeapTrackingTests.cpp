@@ -0,0 +1,99 @@
+#include "Test.h"
+#include "Memory.h"
+#include <memory_resource>
+#include <new>
+#include <vector>
+
+// Built into engine_heap_tests, which compiles Memory.cpp with
+// ENGINE_TRACK_GLOBAL_HEAP so every new/delete is counted.
+
+namespace {
+    struct Particle {
+        float position[3];
+        float velocity[3];
+    };
+
+    // One frame of work written the way the engine's per-frame code should
+    // be: scratch data from the arena, long-lived objects from a pool.
+    void SimulateFrame(LinearArena& arena, ObjectPool<Particle>& pool, std::vector<Particle*>& live) {
+        ArenaMemoryResource resource(arena);
+        std::pmr::vector<uint32_t> visible(&resource);
+        visible.reserve(256);
+        for (uint32_t i = 0; i < 256; ++i) {
+            visible.push_back(i);
+        }
+
+        for (Particle*& particle : live) {
+            pool.Destroy(particle);
+            particle = pool.Create();
+        }
+        arena.Reset();
+    }
+}
+
+TEST(HeapTracking, GlobalNewIsCounted) {
+    uint64_t before = MemoryTracker::GetStats(MemoryTag::General).currentBytes;
+    {
+        MemoryTracker::BeginFrame();
+        std::vector<int> values(1000);
+        CHECK_EQ(MemoryTracker::GetFrameAllocations(), 1u);
+        CHECK(MemoryTracker::GetStats(MemoryTag::General).currentBytes >= before + 1000 * sizeof(int));
+    }
+    CHECK_EQ(MemoryTracker::GetStats(MemoryTag::General).currentBytes, before);
+}
+
+TEST(HeapTracking, AlignedAndNothrowNewAreCounted) {
+    struct alignas(64) CacheLine {
+        float values[16];
+    };
+
+    uint64_t before = MemoryTracker::GetStats(MemoryTag::General).currentBytes;
+    MemoryTracker::BeginFrame();
+    CacheLine* line = new CacheLine();
+    CacheLine* lines = new CacheLine[4];
+    int* value = new (std::nothrow) int(7);
+    CHECK_EQ(MemoryTracker::GetFrameAllocations(), 3u);
+    CHECK_EQ(reinterpret_cast<uintptr_t>(line) % 64, 0u);
+    CHECK_EQ(reinterpret_cast<uintptr_t>(lines) % 64, 0u);
+    CHECK_EQ(*value, 7);
+    CHECK_EQ(MemoryTracker::GetStats(MemoryTag::General).currentBytes,
+             before + sizeof(CacheLine) * 5 + sizeof(int));
+
+    delete line;
+    delete[] lines;
+    delete value;
+    CHECK_EQ(MemoryTracker::GetStats(MemoryTag::General).currentBytes, before);
+}
+
+TEST(HeapTracking, TaggedAllocationsAreNotCountedTwice) {
+    uint64_t before = MemoryTracker::GetStats(MemoryTag::General).currentBytes;
+    {
+        LinearArena arena(4096, MemoryTag::Scratch);
+        CHECK_EQ(MemoryTracker::GetStats(MemoryTag::General).currentBytes, before);
+    }
+    CHECK_EQ(MemoryTracker::GetStats(MemoryTag::General).currentBytes, before);
+}
+
+TEST(HeapTracking, SteadyStateFramesDoNotAllocate) {
+    LinearArena arena(64 * 1024, MemoryTag::Scratch);
+    ObjectPool<Particle> pool(64, MemoryTag::Scene);
+    std::vector<Particle*> live(64, nullptr);
+    FrameAllocationMonitor monitor(1);
+
+    for (int frame = 0; frame < 10; ++frame) {
+        MemoryTracker::BeginFrame();
+        SimulateFrame(arena, pool, live);
+        monitor.EndFrame();
+    }
+
+    CHECK_EQ(monitor.GetAllocatingFrames(), 0u);
+
+    // The same frame with a plain std::vector is caught.
+    MemoryTracker::BeginFrame();
+    std::vector<uint32_t> heapVisible(256);
+    CHECK(monitor.EndFrame() > 0);
+
+    for (Particle* particle : live) {
+        pool.Destroy(particle);
+    }
+}
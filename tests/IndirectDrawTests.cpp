@@ -0,0 +1,91 @@
+#include "Test.h"
+#include "IndirectDraw.h"
+#include <vector>
+
+namespace {
+    IndirectDrawCommand MakeCommand(uint32_t id) {
+        IndirectDrawCommand command = {};
+        command.draw = { 36, 1, id * 36, static_cast<int32_t>(id * 24), 0 };
+        return command;
+    }
+}
+
+TEST(IndirectDraw, PackerWritesCommandsAndCount) {
+    std::vector<IndirectDrawCommand> arguments(8);
+    IndirectArgumentPacker packer;
+    packer.Begin(arguments.data(), 8);
+
+    for (uint32_t i = 0; i < 5; ++i) {
+        CHECK(packer.Push(MakeCommand(i)));
+    }
+
+    uint32_t count = 0;
+    CHECK_EQ(packer.Finish(&count), 5u);
+    CHECK_EQ(count, 5u);
+    for (uint32_t i = 0; i < 5; ++i) {
+        CHECK_EQ(arguments[i].draw.startIndexLocation, i * 36);
+        CHECK_EQ(arguments[i].draw.baseVertexLocation, static_cast<int32_t>(i * 24));
+    }
+}
+
+TEST(IndirectDraw, PackerStopsAtCapacity) {
+    std::vector<IndirectDrawCommand> arguments(3);
+    IndirectArgumentPacker packer;
+    packer.Begin(arguments.data(), 2);
+
+    CHECK(packer.Push(MakeCommand(0)));
+    CHECK(packer.Push(MakeCommand(1)));
+    CHECK(!packer.Push(MakeCommand(2)));
+    CHECK_EQ(packer.GetCount(), 2u);
+    CHECK_EQ(arguments[2].draw.indexCountPerInstance, 0u);
+}
+
+TEST(IndirectDraw, PackerRestartsOnBegin) {
+    std::vector<IndirectDrawCommand> arguments(4);
+    IndirectArgumentPacker packer;
+    packer.Begin(arguments.data(), 4);
+    packer.Push(MakeCommand(0));
+    packer.Push(MakeCommand(1));
+
+    packer.Begin(arguments.data(), 4);
+    packer.Push(MakeCommand(7));
+    CHECK_EQ(packer.Finish(nullptr), 1u);
+    CHECK_EQ(arguments[0].draw.startIndexLocation, 7u * 36);
+}
+
+TEST(IndirectDraw, PackerWithoutBufferAcceptsNothing) {
+    IndirectArgumentPacker packer;
+    packer.Begin(nullptr, 16);
+    CHECK(!packer.Push(MakeCommand(0)));
+    CHECK_EQ(packer.GetCapacity(), 0u);
+}
+
+TEST(IndirectDraw, CompactKeepsVisibleInOrder) {
+    std::vector<IndirectDrawCommand> commands;
+    for (uint32_t i = 0; i < 6; ++i) {
+        commands.push_back(MakeCommand(i));
+    }
+    const uint8_t visibility[] = { 1, 0, 0, 1, 1, 0 };
+
+    std::vector<IndirectDrawCommand> output(6);
+    uint32_t written = CompactDrawCommands(commands.data(), visibility, 6, output.data());
+
+    CHECK_EQ(written, 3u);
+    CHECK_EQ(output[0].draw.startIndexLocation, 0u);
+    CHECK_EQ(output[1].draw.startIndexLocation, 3u * 36);
+    CHECK_EQ(output[2].draw.startIndexLocation, 4u * 36);
+}
+
+TEST(IndirectDraw, CompactHandlesAllAndNone) {
+    std::vector<IndirectDrawCommand> commands = { MakeCommand(0), MakeCommand(1) };
+    std::vector<IndirectDrawCommand> output(2);
+
+    const uint8_t none[] = { 0, 0 };
+    CHECK_EQ(CompactDrawCommands(commands.data(), none, 2, output.data()), 0u);
+
+    const uint8_t all[] = { 1, 255 };
+    CHECK_EQ(CompactDrawCommands(commands.data(), all, 2, output.data()), 2u);
+    CHECK_EQ(output[1].draw.startIndexLocation, 36u);
+
+    CHECK_EQ(CompactDrawCommands(commands.data(), all, 0, output.data()), 0u);
+}
@@ -0,0 +1,215 @@
+#include "Test.h"
+#include "Memory.h"
+#include <memory_resource>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+    uint64_t CurrentBytes(MemoryTag tag) {
+        return MemoryTracker::GetStats(tag).currentBytes;
+    }
+
+    struct Counted {
+        explicit Counted(int& destroyed, int value) : destroyed(destroyed), value(value) {}
+        ~Counted() { ++destroyed; }
+
+        int& destroyed;
+        int value;
+    };
+}
+
+TEST(Memory, TrackerBalancesAllocationsPerTag) {
+    uint64_t before = CurrentBytes(MemoryTag::Geometry);
+    uint64_t totalBefore = MemoryTracker::GetStats(MemoryTag::Geometry).totalAllocations;
+
+    void* a = TrackedAllocate(1000, 16, MemoryTag::Geometry);
+    void* b = TrackedAllocate(24, 64, MemoryTag::Geometry);
+    CHECK(a && b);
+    CHECK_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+    CHECK_EQ(CurrentBytes(MemoryTag::Geometry), before + 1024);
+    CHECK(MemoryTracker::GetStats(MemoryTag::Geometry).peakBytes >= before + 1024);
+    CHECK_EQ(MemoryTracker::GetStats(MemoryTag::Geometry).totalAllocations, totalBefore + 2);
+
+    TrackedFree(a, 1000, 16, MemoryTag::Geometry);
+    TrackedFree(b, 24, 64, MemoryTag::Geometry);
+    TrackedFree(nullptr, 100, 16, MemoryTag::Geometry);
+    CHECK_EQ(CurrentBytes(MemoryTag::Geometry), before);
+}
+
+TEST(Memory, BeginFrameResetsFrameAllocations) {
+    MemoryTracker::BeginFrame();
+    CHECK_EQ(MemoryTracker::GetFrameAllocations(), 0u);
+
+    void* block = TrackedAllocate(32, 16, MemoryTag::Scratch);
+    CHECK_EQ(MemoryTracker::GetFrameAllocations(), 1u);
+    CHECK_EQ(MemoryTracker::GetStats(MemoryTag::Scratch).frameAllocations, 1u);
+
+    MemoryTracker::BeginFrame();
+    CHECK_EQ(MemoryTracker::GetFrameAllocations(), 0u);
+    TrackedFree(block, 32, 16, MemoryTag::Scratch);
+}
+
+TEST(Memory, FrameAllocationMonitorIgnoresWarmup) {
+    FrameAllocationMonitor monitor(2);
+    void* block = nullptr;
+
+    for (int frame = 0; frame < 5; ++frame) {
+        MemoryTracker::BeginFrame();
+        if (frame == 1 || frame == 3) {
+            block = TrackedAllocate(16, 16, MemoryTag::Scratch);
+            TrackedFree(block, 16, 16, MemoryTag::Scratch);
+        }
+        uint64_t allocations = monitor.EndFrame();
+        CHECK_EQ(allocations, frame == 3 ? 1u : 0u);
+    }
+
+    CHECK_EQ(monitor.GetFrames(), 5u);
+    CHECK_EQ(monitor.GetAllocatingFrames(), 1u);
+    CHECK_EQ(monitor.GetSteadyStateAllocations(), 1u);
+}
+
+TEST(Memory, LinearArenaReleasesOnDestruction) {
+    uint64_t before = CurrentBytes(MemoryTag::Scratch);
+    {
+        LinearArena arena(512, MemoryTag::Scratch);
+        CHECK_EQ(CurrentBytes(MemoryTag::Scratch), before + 512);
+
+        void* a = arena.Allocate(100, 16);
+        void* b = arena.Allocate(100, 64);
+        CHECK(a && b);
+        CHECK_EQ(reinterpret_cast<uintptr_t>(b) % 64, 0u);
+        CHECK(arena.Allocate(400) == nullptr);
+
+        size_t used = arena.GetUsed();
+        {
+            ArenaScope scope(arena);
+            CHECK(arena.Allocate(16) != nullptr);
+        }
+        CHECK_EQ(arena.GetUsed(), used);
+        CHECK(arena.GetPeak() >= used + 16);
+
+        arena.Reset();
+        CHECK_EQ(arena.GetUsed(), 0u);
+    }
+    CHECK_EQ(CurrentBytes(MemoryTag::Scratch), before);
+}
+
+TEST(Memory, ArenaMemoryResourceDoesNotLeak) {
+    uint64_t before = CurrentBytes(MemoryTag::Scratch);
+    {
+        LinearArena arena(64 * 1024, MemoryTag::Scratch);
+        ArenaMemoryResource resource(arena);
+        {
+            std::pmr::vector<int> values(&resource);
+            for (int i = 0; i < 1000; ++i) {
+                values.push_back(i);
+            }
+            CHECK_EQ(values[999], 999);
+            CHECK(arena.GetUsed() >= 1000 * sizeof(int));
+        }
+        // Arena memory is only reclaimed by the arena, never the heap.
+        CHECK_EQ(CurrentBytes(MemoryTag::Scratch), before + 64 * 1024);
+
+        arena.Reset();
+        bool threw = false;
+        try {
+            void* block = resource.allocate(128 * 1024);
+            resource.deallocate(block, 128 * 1024);
+        } catch (const std::bad_alloc&) {
+            threw = true;
+        }
+        CHECK(threw);
+
+        LinearArena other(16, MemoryTag::Scratch);
+        ArenaMemoryResource sameArena(arena);
+        ArenaMemoryResource otherArena(other);
+        CHECK(resource.is_equal(sameArena));
+        CHECK(!resource.is_equal(otherArena));
+    }
+    CHECK_EQ(CurrentBytes(MemoryTag::Scratch), before);
+}
+
+TEST(Memory, TrackingMemoryResourceDoesNotLeak) {
+    uint64_t before = CurrentBytes(MemoryTag::Scene);
+    {
+        TrackingMemoryResource resource(MemoryTag::Scene);
+        std::pmr::vector<std::pmr::string> names(&resource);
+        for (int i = 0; i < 100; ++i) {
+            names.emplace_back("a string long enough to need a heap buffer #" + std::to_string(i));
+        }
+        CHECK(CurrentBytes(MemoryTag::Scene) > before);
+
+        names.erase(names.begin(), names.begin() + 50);
+        names.shrink_to_fit();
+        CHECK(CurrentBytes(MemoryTag::Scene) > before);
+    }
+    CHECK_EQ(CurrentBytes(MemoryTag::Scene), before);
+}
+
+TEST(Memory, ObjectPoolDestroysAndRecycles) {
+    uint64_t before = CurrentBytes(MemoryTag::Scene);
+    int destroyed = 0;
+    {
+        ObjectPool<Counted> pool(4, MemoryTag::Scene);
+        CHECK(CurrentBytes(MemoryTag::Scene) > before);
+
+        std::vector<Counted*> objects;
+        for (int i = 0; i < 4; ++i) {
+            objects.push_back(pool.Create(destroyed, i));
+            CHECK(objects.back() != nullptr);
+        }
+        CHECK(pool.Create(destroyed, 4) == nullptr);
+        CHECK_EQ(pool.GetCount(), 4u);
+
+        pool.Destroy(objects[1]);
+        CHECK_EQ(destroyed, 1);
+        Counted* reused = pool.Create(destroyed, 10);
+        CHECK(reused == objects[1]);
+        CHECK_EQ(reused->value, 10);
+        objects[1] = reused;
+
+        for (Counted* object : objects) {
+            pool.Destroy(object);
+        }
+        pool.Destroy(nullptr);
+        CHECK_EQ(destroyed, 5);
+        CHECK_EQ(pool.GetCount(), 0u);
+    }
+    CHECK_EQ(CurrentBytes(MemoryTag::Scene), before);
+}
+
+TEST(Memory, PoolAllocatorRejectsForeignBlocks) {
+    PoolAllocator pool(24, 2, MemoryTag::Scene);
+    void* a = pool.Allocate();
+    int local = 0;
+
+    CHECK(pool.Owns(a));
+    CHECK(!pool.Owns(&local));
+    CHECK(!pool.Owns(static_cast<unsigned char*>(a) + 1));
+
+    pool.Free(&local);
+    CHECK_EQ(pool.GetUsedBlocks(), 1u);
+    pool.Free(a);
+    CHECK_EQ(pool.GetUsedBlocks(), 0u);
+}
+
+#ifdef NDEBUG
+// Debug builds assert instead.
+TEST(Memory, PoolAllocatorIgnoresDoubleFree) {
+    PoolAllocator pool(24, 2, MemoryTag::Scene);
+    void* a = pool.Allocate();
+    void* b = pool.Allocate();
+
+    pool.Free(a);
+    pool.Free(a);
+    CHECK_EQ(pool.GetUsedBlocks(), 1u);
+
+    void* c = pool.Allocate();
+    CHECK(c == a);
+    CHECK(pool.Allocate() == nullptr);
+    pool.Free(b);
+    pool.Free(c);
+    CHECK_EQ(pool.GetUsedBlocks(), 0u);
+}
+#endif
@@ -0,0 +1,123 @@
+#include "Test.h"
+#include "NullBackend.h"
+#include <cstdint>
+#include <vector>
+
+namespace {
+    const uint32_t Indices[] = { 0, 1, 2 };
+
+    void CreateTriangleBuffers(NullBackend& backend) {
+        backend.CreateBuffer({ 0, BufferUsage::Vertex, 3 * 28, 0, 28, 0 });
+        backend.CreateBuffer({ 1, BufferUsage::Index, sizeof(Indices), 0, 0, 42 });
+        backend.UploadBuffer(1, 0, Indices, sizeof(Indices));
+    }
+}
+
+TEST(NullBackend, CountsValidDraws) {
+    NullBackend backend;
+    CreateTriangleBuffers(backend);
+    backend.DrawIndexed({ 3, 2, 0, 0, 0 });
+    backend.EndFrame();
+
+    CHECK_EQ(backend.GetCounters().frames, 1u);
+    CHECK_EQ(backend.GetCounters().drawCalls, 1u);
+    CHECK_EQ(backend.GetCounters().indices, 6u);
+    CHECK_EQ(backend.GetCounters().bytesUploaded, sizeof(Indices));
+    CHECK_EQ(backend.GetCounters().invalidCommands, 0u);
+}
+
+TEST(NullBackend, RejectsOutOfRangeUploads) {
+    NullBackend backend;
+    CreateTriangleBuffers(backend);
+    uint8_t bytes[16] = {};
+
+    backend.UploadBuffer(1, UINT64_MAX - 4, bytes, 8);
+    backend.UploadBuffer(1, sizeof(Indices) + 1, bytes, 0);
+    backend.UploadBuffer(1, 4, bytes, sizeof(Indices));
+    backend.UploadBuffer(7, 0, bytes, 4);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 4u);
+
+    backend.UploadBuffer(1, sizeof(Indices), bytes, 0);
+    backend.UploadBuffer(1, 4, bytes, 8);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 4u);
+}
+
+TEST(NullBackend, RejectsOversizedBuffers) {
+    NullBackend backend;
+    backend.CreateBuffer({ 0xffffffffu, BufferUsage::Vertex, 64, 0, 28, 0 });
+    backend.CreateBuffer({ NullBackend::MaxBufferId + 1, BufferUsage::Index, 64, 0, 0, 42 });
+    backend.CreateBuffer({ 2, BufferUsage::IndirectArguments, NullBackend::MaxBufferSize + 1, 0, 0, 0 });
+    backend.CreateBuffer({ 3, BufferUsage::Vertex, UINT64_MAX, 0, 28, 0 });
+    CHECK_EQ(backend.GetCounters().invalidCommands, 4u);
+
+    // Rejected buffers are not bound, so draws have nothing to read.
+    backend.DrawIndexed({ 3, 1, 0, 0, 0 });
+    CHECK_EQ(backend.GetCounters().drawCalls, 0u);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 5u);
+
+    backend.CreateBuffer({ NullBackend::MaxBufferId, BufferUsage::Vertex, 64, 0, 28, 0 });
+    CHECK_EQ(backend.GetCounters().invalidCommands, 5u);
+}
+
+TEST(NullBackend, RejectsDrawsOutsideBuffers) {
+    NullBackend backend;
+    CreateTriangleBuffers(backend);
+
+    backend.DrawIndexed({ 4, 1, 0, 0, 0 });
+    backend.DrawIndexed({ 3, 1, 1, 0, 0 });
+    backend.DrawIndexed({ 3, 1, 0, 1, 0 });
+    backend.DrawIndexed({ 3, 1, 0, -1, 0 });
+    CHECK_EQ(backend.GetCounters().drawCalls, 0u);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 4u);
+}
+
+TEST(NullBackend, ExecutesIndirectCommands) {
+    NullBackend backend;
+    CreateTriangleBuffers(backend);
+    backend.CreateBuffer({ 2, BufferUsage::IndirectArguments, 4 * sizeof(IndirectDrawCommand), 0, 0, 0 });
+    backend.CreateBuffer({ 3, BufferUsage::IndirectCount, sizeof(uint32_t), 0, 0, 0 });
+
+    std::vector<IndirectDrawCommand> commands(4);
+    commands[0].draw = { 3, 1, 0, 0, 0 };
+    commands[1].draw = { 3, 1, 0, 5, 0 };
+    commands[2].draw = { 3, 1, 0, 0, 0 };
+    uint32_t count = 3;
+    backend.UploadBuffer(2, 0, commands.data(), static_cast<uint32_t>(commands.size() * sizeof(IndirectDrawCommand)));
+    backend.UploadBuffer(3, 0, &count, sizeof(count));
+
+    backend.ExecuteIndirect(2, 3, 4);
+    CHECK_EQ(backend.GetCounters().drawCalls, 2u);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 1u);
+
+    // A count larger than the argument buffer is rejected outright.
+    count = 100;
+    backend.UploadBuffer(3, 0, &count, sizeof(count));
+    backend.ExecuteIndirect(2, 3, 100);
+    CHECK_EQ(backend.GetCounters().drawCalls, 2u);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 2u);
+
+    backend.ExecuteIndirect(2, 9, 4);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 3u);
+}
+
+TEST(NullBackend, CountsWithoutValidation) {
+    NullBackend backend;
+    backend.SetValidation(false);
+    CreateTriangleBuffers(backend);
+
+    // Out of range, but only counted: nothing reads the buffers.
+    backend.DrawIndexed({ 3, 1, 0, 100, 0 });
+    backend.DrawIndexed({ 3, 1, 0, 0, 0 });
+    CHECK_EQ(backend.GetCounters().drawCalls, 2u);
+    CHECK_EQ(backend.GetCounters().indices, 6u);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 0u);
+
+    // Malformed commands are still rejected.
+    backend.ExecuteIndirect(7, 8, 4);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 1u);
+
+    backend.SetValidation(true);
+    backend.DrawIndexed({ 3, 1, 0, 100, 0 });
+    CHECK_EQ(backend.GetCounters().drawCalls, 2u);
+    CHECK_EQ(backend.GetCounters().invalidCommands, 2u);
+}
@@ -0,0 +1,123 @@
+#include "Test.h"
+#include "Parallel.h"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    // Restores the default worker count when a test ends.
+    struct WorkerCountScope {
+        explicit WorkerCountScope(uint32_t count) { SetWorkerCount(count); }
+        ~WorkerCountScope() { SetWorkerCount(0); }
+    };
+
+    bool CoversEachIndexOnce(uint32_t count, uint32_t grainSize) {
+        std::vector<std::atomic<uint32_t>> hits(count);
+        ParallelFor(count, grainSize, [&hits](uint32_t begin, uint32_t end) {
+            for (uint32_t i = begin; i < end; ++i) {
+                hits[i].fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+
+        for (const auto& hit : hits) {
+            if (hit.load() != 1) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+TEST(Parallel, CoversEachIndexOnce) {
+    for (uint32_t workers : { 1u, 2u, 4u, 7u }) {
+        WorkerCountScope scope(workers);
+        CHECK(CoversEachIndexOnce(1, 1));
+        CHECK(CoversEachIndexOnce(10, 1));
+        CHECK(CoversEachIndexOnce(1000, 16));
+        CHECK(CoversEachIndexOnce(1001, 100));
+        CHECK(CoversEachIndexOnce(5, 64));
+    }
+}
+
+TEST(Parallel, SmallRangesRunInline) {
+    WorkerCountScope scope(4);
+    std::thread::id caller = std::this_thread::get_id();
+    std::thread::id ranOn;
+    uint32_t calls = 0;
+
+    ParallelFor(100, 100, [&](uint32_t begin, uint32_t end) {
+        ranOn = std::this_thread::get_id();
+        ++calls;
+        CHECK_EQ(begin, 0u);
+        CHECK_EQ(end, 100u);
+    });
+    CHECK(ranOn == caller);
+    CHECK_EQ(calls, 1u);
+
+    ParallelFor(0, 1, [&](uint32_t, uint32_t) { ++calls; });
+    CHECK_EQ(calls, 1u);
+}
+
+TEST(Parallel, RethrowsOnCallingThread) {
+    WorkerCountScope scope(4);
+    std::atomic<uint32_t> chunks{ 0 };
+    bool caught = false;
+
+    try {
+        ParallelFor(64, 1, [&chunks](uint32_t begin, uint32_t) {
+            chunks.fetch_add(1);
+            if (begin == 16) {
+                throw std::runtime_error("chunk failed");
+            }
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    CHECK(caught);
+    CHECK(chunks.load() >= 1);
+
+    // The pool keeps working after a failed call.
+    CHECK(CoversEachIndexOnce(4096, 1));
+}
+
+TEST(Parallel, NestedCallsComplete) {
+    WorkerCountScope scope(4);
+    std::vector<std::atomic<uint32_t>> hits(16 * 64);
+
+    ParallelFor(16, 1, [&hits](uint32_t outerBegin, uint32_t outerEnd) {
+        for (uint32_t outer = outerBegin; outer < outerEnd; ++outer) {
+            ParallelFor(64, 8, [&hits, outer](uint32_t begin, uint32_t end) {
+                for (uint32_t i = begin; i < end; ++i) {
+                    hits[outer * 64 + i].fetch_add(1, std::memory_order_relaxed);
+                }
+            });
+        }
+    });
+
+    bool allOnce = true;
+    for (const auto& hit : hits) {
+        allOnce = allOnce && hit.load() == 1;
+    }
+    CHECK(allOnce);
+}
+
+TEST(Parallel, ConcurrentCallersShareThePool) {
+    WorkerCountScope scope(4);
+    std::atomic<bool> allOnce{ true };
+    std::vector<std::thread> callers;
+
+    for (int caller = 0; caller < 3; ++caller) {
+        callers.emplace_back([&allOnce]() {
+            for (int call = 0; call < 200; ++call) {
+                if (!CoversEachIndexOnce(257, 8)) {
+                    allOnce = false;
+                }
+            }
+        });
+    }
+    for (auto& caller : callers) {
+        caller.join();
+    }
+    CHECK(allOnce.load());
+}
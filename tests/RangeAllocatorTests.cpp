@@ -0,0 +1,73 @@
+#include "Test.h"
+#include "RangeAllocator.h"
+
+TEST(RangeAllocator, AllocatesFirstFit) {
+    RangeAllocator allocator(100);
+    uint32_t a = 0, b = 0, c = 0;
+
+    CHECK(allocator.Allocate(10, a));
+    CHECK(allocator.Allocate(20, b));
+    CHECK_EQ(a, 0u);
+    CHECK_EQ(b, 10u);
+
+    allocator.Free(a, 10);
+    CHECK(allocator.Allocate(5, c));
+    CHECK_EQ(c, 0u);
+    CHECK_EQ(allocator.GetUsed(), 25u);
+    CHECK_EQ(allocator.GetHighWaterMark(), 30u);
+}
+
+TEST(RangeAllocator, RejectsZeroAndOversizedRequests) {
+    RangeAllocator allocator(16);
+    uint32_t offset = 0;
+
+    CHECK(!allocator.Allocate(0, offset));
+    CHECK(!allocator.Allocate(17, offset));
+    CHECK(allocator.Allocate(16, offset));
+    CHECK(!allocator.Allocate(1, offset));
+    CHECK_EQ(allocator.GetLargestFreeRange(), 0u);
+}
+
+TEST(RangeAllocator, CoalescesWithBothNeighbours) {
+    RangeAllocator allocator(40);
+    uint32_t offsets[4] = {};
+    for (uint32_t& offset : offsets) {
+        CHECK(allocator.Allocate(10, offset));
+    }
+
+    // Free out of order so each case is hit: no neighbour, next neighbour,
+    // previous neighbour, then both.
+    allocator.Free(offsets[0], 10);
+    CHECK_EQ(allocator.GetLargestFreeRange(), 10u);
+    allocator.Free(offsets[2], 10);
+    CHECK_EQ(allocator.GetLargestFreeRange(), 10u);
+    allocator.Free(offsets[3], 10);
+    CHECK_EQ(allocator.GetLargestFreeRange(), 20u);
+    allocator.Free(offsets[1], 10);
+    CHECK_EQ(allocator.GetLargestFreeRange(), 40u);
+    CHECK_EQ(allocator.GetUsed(), 0u);
+
+    uint32_t whole = 1;
+    CHECK(allocator.Allocate(40, whole));
+    CHECK_EQ(whole, 0u);
+}
+
+TEST(RangeAllocator, FragmentationLimitsLargestRange) {
+    RangeAllocator allocator(30);
+    uint32_t a = 0, b = 0, c = 0;
+    CHECK(allocator.Allocate(10, a));
+    CHECK(allocator.Allocate(10, b));
+    CHECK(allocator.Allocate(10, c));
+
+    allocator.Free(a, 10);
+    allocator.Free(c, 10);
+    CHECK_EQ(allocator.GetUsed(), 10u);
+    CHECK_EQ(allocator.GetLargestFreeRange(), 10u);
+
+    uint32_t offset = 0;
+    CHECK(!allocator.Allocate(20, offset));
+
+    allocator.Reset(30);
+    CHECK_EQ(allocator.GetLargestFreeRange(), 30u);
+    CHECK_EQ(allocator.GetHighWaterMark(), 0u);
+}
@@ -0,0 +1,250 @@
+#include "Test.h"
+#include "RangeAllocator.h"
+#include "ResidencyManager.h"
+#include <vector>
+
+namespace {
+    constexpr uint32_t MeshVertices = 4;
+    constexpr uint32_t MeshIndices = 6;
+    constexpr uint64_t MeshBytes = MeshVertices * sizeof(Vertex) + MeshIndices * sizeof(uint32_t);
+
+    // Places meshes in two RangeAllocators like GeometryPool and records
+    // what it was asked to do.
+    class MockGeometryDevice : public IGeometryDevice {
+    public:
+        MockGeometryDevice(uint32_t maxVertices, uint32_t maxIndices)
+            : m_vertices(maxVertices), m_indices(maxIndices) {}
+
+        bool Upload(const MeshView& mesh, GpuMeshRange& range) override {
+            uint32_t vertexOffset = 0;
+            uint32_t indexOffset = 0;
+            if (!m_vertices.Allocate(mesh.vertexCount, vertexOffset)) {
+                return false;
+            }
+            if (!m_indices.Allocate(mesh.indexCount, indexOffset)) {
+                m_vertices.Free(vertexOffset, mesh.vertexCount);
+                return false;
+            }
+
+            range = { vertexOffset, mesh.vertexCount, indexOffset, mesh.indexCount };
+            uploadedTags.push_back(mesh.vertices[0].position.x);
+            return true;
+        }
+
+        void Evict(const GpuMeshRange& range) override {
+            m_vertices.Free(range.vertexOffset, range.vertexCount);
+            m_indices.Free(range.indexOffset, range.indexCount);
+            evictedVertexOffsets.push_back(range.vertexOffset);
+        }
+
+        uint32_t GetUsedVertices() const { return m_vertices.GetUsed(); }
+
+        // Position.x of the first vertex of every upload, in order.
+        std::vector<float> uploadedTags;
+        std::vector<uint32_t> evictedVertexOffsets;
+
+    private:
+        RangeAllocator m_vertices;
+        RangeAllocator m_indices;
+    };
+
+    MeshData MakeMesh(float tag) {
+        MeshData mesh;
+        mesh.vertices.assign(MeshVertices, Vertex{ { tag, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f, 1.0f } });
+        mesh.indices = { 0, 1, 2, 0, 2, 3 };
+        return mesh;
+    }
+
+    // count copies of MakeMesh(tag) in one mesh.
+    MeshData MakeMeshes(float tag, uint32_t count) {
+        MeshData mesh;
+        for (uint32_t i = 0; i < count; ++i) {
+            MeshData quad = MakeMesh(tag);
+            for (uint32_t index : quad.indices) {
+                mesh.indices.push_back(index + i * MeshVertices);
+            }
+            mesh.vertices.insert(mesh.vertices.end(), quad.vertices.begin(), quad.vertices.end());
+        }
+        return mesh;
+    }
+}
+
+TEST(Residency, EvictsLeastRecentlyUsedFirst) {
+    MockGeometryDevice device(1024, 1024);
+    ResidencyManager residency(device, MeshBytes * 3);
+    GpuMeshRange range = {};
+
+    MeshHandle a = residency.Register(MakeMesh(1.0f));
+    MeshHandle b = residency.Register(MakeMesh(2.0f));
+    MeshHandle c = residency.Register(MakeMesh(3.0f));
+    CHECK_EQ(residency.GetResidentBytes(), MeshBytes * 3);
+
+    residency.BeginFrame(1);
+    CHECK(residency.Request(a, range));
+    residency.BeginFrame(2);
+    CHECK(residency.Request(c, range));
+    residency.BeginFrame(3);
+    CHECK(residency.Request(b, range));
+
+    // a was used longest ago, then c.
+    residency.BeginFrame(4);
+    MeshHandle d = residency.Register(MakeMesh(4.0f));
+    CHECK(!residency.IsResident(a));
+    CHECK(residency.IsResident(b) && residency.IsResident(c) && residency.IsResident(d));
+
+    MeshHandle e = residency.Register(MakeMesh(5.0f));
+    CHECK(!residency.IsResident(c));
+    CHECK(residency.IsResident(b) && residency.IsResident(d) && residency.IsResident(e));
+    CHECK_EQ(residency.GetEvictionCount(), 2u);
+    CHECK_EQ(residency.GetResidentBytes(), MeshBytes * 3);
+    CHECK_EQ(device.evictedVertexOffsets.size(), 2u);
+    CHECK_EQ(device.GetUsedVertices(), MeshVertices * 3);
+}
+
+TEST(Residency, MeshThatCannotFitEvictsNothing) {
+    MockGeometryDevice device(1024, 1024);
+    ResidencyManager residency(device, MeshBytes * 3);
+    GpuMeshRange range = {};
+
+    MeshHandle a = residency.Register(MakeMesh(1.0f));
+    MeshHandle b = residency.Register(MakeMesh(2.0f));
+    MeshHandle c = residency.Register(MakeMesh(3.0f));
+
+    residency.BeginFrame(1);
+    // Larger than the whole budget.
+    MeshHandle d = residency.Register(MakeMeshes(10.0f, 4));
+    CHECK(d != InvalidMeshHandle);
+    CHECK(!residency.Request(d, range));
+    CHECK_EQ(residency.GetEvictionCount(), 0u);
+    CHECK(residency.IsResident(a) && residency.IsResident(b) && residency.IsResident(c));
+
+    residency.BeginFrame(2);
+    CHECK(residency.Request(a, range));
+    // Fits the budget, but not beside the mesh pinned by this frame.
+    MeshHandle e = residency.Register(MakeMeshes(20.0f, 3));
+    CHECK(!residency.IsResident(e));
+    CHECK_EQ(residency.GetEvictionCount(), 0u);
+    CHECK(residency.IsResident(b) && residency.IsResident(c));
+
+    // Once nothing is pinned it replaces all three.
+    residency.BeginFrame(3);
+    CHECK(residency.Request(e, range));
+    CHECK_EQ(residency.GetEvictionCount(), 3u);
+    CHECK_EQ(residency.GetResidentBytes(), MeshBytes * 3);
+}
+
+TEST(Residency, PinsMeshesUsedThisFrame) {
+    MockGeometryDevice device(1024, 1024);
+    ResidencyManager residency(device, MeshBytes * 2);
+    GpuMeshRange range = {};
+
+    MeshHandle a = residency.Register(MakeMesh(1.0f));
+    MeshHandle b = residency.Register(MakeMesh(2.0f));
+
+    residency.BeginFrame(1);
+    CHECK(residency.Request(a, range));
+    GpuMeshRange rangeA = range;
+    CHECK(residency.Request(b, range));
+
+    // Both residents are in use this frame, so the newcomer has to wait.
+    MeshHandle c = residency.Register(MakeMesh(3.0f));
+    CHECK(c != InvalidMeshHandle);
+    CHECK(!residency.IsResident(c));
+    CHECK(!residency.Request(c, range));
+    CHECK(residency.IsResident(a) && residency.IsResident(b));
+    CHECK_EQ(residency.GetEvictionCount(), 0u);
+
+    residency.SetBudget(MeshBytes);
+    CHECK(residency.IsResident(a) && residency.IsResident(b));
+    residency.SetBudget(MeshBytes * 2);
+
+    residency.BeginFrame(2);
+    CHECK(residency.Request(c, range));
+    CHECK_EQ(residency.GetEvictionCount(), 1u);
+    CHECK(!residency.IsResident(a));
+    // The freed range is reused by the newcomer.
+    CHECK_EQ(range.vertexOffset, rangeA.vertexOffset);
+}
+
+TEST(Residency, RestoresFromSourceAfterReleasingCpuData) {
+    MockGeometryDevice device(1024, 1024);
+    ResidencyManager residency(device, MeshBytes);
+    int sourceCalls = 0;
+    MeshSource source = [&sourceCalls](MeshData& data) {
+        ++sourceCalls;
+        data = MakeMesh(7.0f);
+        return true;
+    };
+
+    MeshHandle a = residency.Register(MakeMesh(7.0f), source);
+    CHECK(residency.ReleaseCpuData(a));
+    CHECK_EQ(residency.GetCpuBytes(), 0u);
+
+    residency.BeginFrame(1);
+    MeshHandle b = residency.RegisterStatic(MakeMesh(8.0f).GetView());
+    CHECK(!residency.IsResident(a));
+    CHECK(residency.IsResident(b));
+    CHECK_EQ(sourceCalls, 0);
+
+    residency.BeginFrame(2);
+    GpuMeshRange range = {};
+    CHECK(residency.Request(a, range));
+    CHECK_EQ(sourceCalls, 1);
+    CHECK_EQ(range.vertexCount, MeshVertices);
+    CHECK_EQ(range.indexCount, MeshIndices);
+    CHECK_EQ(device.uploadedTags.back(), 7.0f);
+    // The restored copy is dropped again once it is on the GPU.
+    CHECK_EQ(residency.GetCpuBytes(), 0u);
+}
+
+TEST(Residency, FailedRestoreLeavesMeshEvicted) {
+    MockGeometryDevice device(1024, 1024);
+    ResidencyManager residency(device, MeshBytes);
+    MeshHandle a = residency.Register(MakeMesh(1.0f), [](MeshData&) { return false; });
+    CHECK(residency.ReleaseCpuData(a));
+
+    residency.BeginFrame(1);
+    MeshHandle b = residency.Register(MakeMesh(2.0f));
+    CHECK(!residency.IsResident(a));
+
+    residency.BeginFrame(2);
+    GpuMeshRange range = {};
+    CHECK(!residency.Request(a, range));
+    CHECK(residency.IsResident(b));
+    CHECK_EQ(residency.GetCpuBytes(), MakeMesh(2.0f).GetCapacityInBytes());
+}
+
+TEST(Residency, ReleasingWithoutSourcePinsMesh) {
+    MockGeometryDevice device(1024, 1024);
+    ResidencyManager residency(device, MeshBytes);
+
+    MeshHandle a = residency.Register(MakeMesh(1.0f));
+    CHECK(residency.ReleaseCpuData(a));
+
+    residency.BeginFrame(1);
+    MeshHandle b = residency.Register(MakeMesh(2.0f));
+    CHECK(residency.IsResident(a));
+    CHECK(!residency.IsResident(b));
+    CHECK_EQ(residency.GetEvictionCount(), 0u);
+}
+
+TEST(Residency, CpuBytesDropAfterRelease) {
+    MockGeometryDevice device(1024, 1024);
+    ResidencyManager residency(device, MeshBytes * 4);
+
+    MeshHandle a = residency.Register(MakeMesh(1.0f));
+    MeshHandle b = residency.Register(MakeMesh(2.0f));
+    uint64_t bothBytes = residency.GetCpuBytes();
+    CHECK(bothBytes >= MeshBytes * 2);
+
+    CHECK(residency.ReleaseCpuData(a));
+    CHECK_EQ(residency.GetCpuBytes(), bothBytes / 2);
+    CHECK(residency.ReleaseCpuData(b));
+    CHECK_EQ(residency.GetCpuBytes(), 0u);
+    CHECK(!residency.ReleaseCpuData(InvalidMeshHandle));
+
+    residency.Unregister(a);
+    CHECK(!residency.IsResident(a));
+    CHECK_EQ(residency.GetResidentBytes(), MeshBytes);
+    CHECK_EQ(device.GetUsedVertices(), MeshVertices);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <filesystem>
+#include <string>
+
+// Minimal self-registering test cases. Each suite is registered with ctest
+// separately (see tests/CMakeLists.txt) by running engine_tests <Suite>.
+using TestFunction = void (*)();
+
+struct TestRegistrar {
+    TestRegistrar(const char* suite, const char* name, TestFunction function);
+};
+
+void ReportFailure(const char* file, int line, const char* expression);
+
+// Fresh, empty directory under the system temp directory, unique per call.
+std::filesystem::path MakeTestDirectory(const std::string& name);
+
+#define TEST(suite, name) \
+    static void suite##_##name(); \
+    static TestRegistrar suite##_##name##_registrar(#suite, #name, suite##_##name); \
+    static void suite##_##name()
+
+#define CHECK(expression) \
+    do { \
+        if (!(expression)) { \
+            ReportFailure(__FILE__, __LINE__, #expression); \
+        } \
+    } while (0)
+
+#define CHECK_EQ(actual, expected) CHECK((actual) == (expected))
@@ -0,0 +1,72 @@
+#include "Test.h"
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#include <process.h>
+#define ENGINE_TEST_PID _getpid()
+#else
+#include <unistd.h>
+#define ENGINE_TEST_PID getpid()
+#endif
+
+namespace {
+    struct TestCase {
+        const char* suite;
+        const char* name;
+        TestFunction function;
+    };
+
+    std::vector<TestCase>& GetRegistry() {
+        static std::vector<TestCase> registry;
+        return registry;
+    }
+
+    std::atomic<int> g_failures{ 0 };
+}
+
+TestRegistrar::TestRegistrar(const char* suite, const char* name, TestFunction function) {
+    GetRegistry().push_back({ suite, name, function });
+}
+
+void ReportFailure(const char* file, int line, const char* expression) {
+    std::cerr << file << ":" << line << ": CHECK failed: " << expression << "\n";
+    ++g_failures;
+}
+
+std::filesystem::path MakeTestDirectory(const std::string& name) {
+    static int counter = 0;
+    std::filesystem::path path = std::filesystem::temp_directory_path() /
+        ("engine_tests_" + std::to_string(ENGINE_TEST_PID) + "_" + name + "_" + std::to_string(counter++));
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    return path;
+}
+
+// engine_tests [suite]: runs every test, or only those of one suite.
+int main(int argc, char** argv) {
+    const char* suite = argc > 1 ? argv[1] : nullptr;
+    int ran = 0;
+
+    for (const TestCase& test : GetRegistry()) {
+        if (suite && std::strcmp(suite, test.suite) != 0) {
+            continue;
+        }
+
+        int failuresBefore = g_failures;
+        test.function();
+        std::cout << (g_failures == failuresBefore ? "[ PASS ] " : "[ FAIL ] ")
+            << test.suite << "." << test.name << "\n";
+        ++ran;
+    }
+
+    if (ran == 0) {
+        std::cerr << "No tests matched" << (suite ? std::string(" suite ") + suite : std::string()) << "\n";
+        return 1;
+    }
+
+    std::cout << ran << " test(s), " << g_failures << " failure(s)\n";
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,115 @@
+#include "Test.h"
+#include "Transform.h"
+#include <cmath>
+
+namespace {
+    constexpr float Pi = 3.14159265358979323846f;
+    constexpr float Epsilon = 1e-5f;
+
+    bool Near(float a, float b) {
+        return std::fabs(a - b) < Epsilon;
+    }
+
+    bool Near(const Float3& a, const Float3& b) {
+        return Near(a.x, b.x) && Near(a.y, b.y) && Near(a.z, b.z);
+    }
+
+    bool Near(const Float4x4& a, const Float4x4& b) {
+        for (int row = 0; row < 4; ++row) {
+            for (int column = 0; column < 4; ++column) {
+                if (!Near(a.m[row][column], b.m[row][column])) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+}
+
+TEST(Transform, LookAtMatchesReference) {
+    // Looking down -X from +X: world +Z is to the right.
+    Float4x4 view = MakeLookAtLH({ 5.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f });
+    Float4x4 expected = { {
+        { 0.0f, 0.0f, -1.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 1.0f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 5.0f, 1.0f },
+    } };
+    CHECK(Near(view, expected));
+
+    CHECK(Near(MakeLookAtLH({ 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 1.0f }, { 0.0f, 1.0f, 0.0f }), MakeIdentity()));
+}
+
+TEST(Transform, LookAtPutsTargetOnViewAxis) {
+    Float3 eye = { 2.0f, 3.0f, -4.0f };
+    Float3 target = { -1.0f, 0.5f, 2.0f };
+    Float4x4 view = MakeLookAtLH(eye, target, { 0.0f, 1.0f, 0.0f });
+
+    float dx = target.x - eye.x;
+    float dy = target.y - eye.y;
+    float dz = target.z - eye.z;
+    float distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+    CHECK(Near(TransformPoint(eye, view), { 0.0f, 0.0f, 0.0f }));
+    CHECK(Near(TransformPoint(target, view), { 0.0f, 0.0f, distance }));
+
+    // The rotation part is orthonormal.
+    for (int a = 0; a < 3; ++a) {
+        for (int b = 0; b < 3; ++b) {
+            float dot = view.m[a][0] * view.m[b][0] + view.m[a][1] * view.m[b][1] + view.m[a][2] * view.m[b][2];
+            CHECK(Near(dot, a == b ? 1.0f : 0.0f));
+        }
+    }
+}
+
+TEST(Transform, PerspectiveMatchesReference) {
+    Float4x4 projection = MakePerspectiveFovLH(Pi / 2.0f, 2.0f, 1.0f, 101.0f);
+    Float4x4 expected = { {
+        { 0.5f, 0.0f, 0.0f, 0.0f },
+        { 0.0f, 1.0f, 0.0f, 0.0f },
+        { 0.0f, 0.0f, 1.01f, 1.0f },
+        { 0.0f, 0.0f, -1.01f, 0.0f },
+    } };
+    CHECK(Near(projection, expected));
+
+    // Depth maps the near plane to 0 and the far plane to 1 after the divide.
+    const auto& m = projection.m;
+    for (float z : { 1.0f, 101.0f }) {
+        float clipZ = z * m[2][2] + m[3][2];
+        float clipW = z * m[2][3] + m[3][3];
+        CHECK(Near(clipZ / clipW, z == 1.0f ? 0.0f : 1.0f));
+    }
+}
+
+TEST(Transform, RotationIsRollThenPitchThenYaw) {
+    const Float3 rotations[] = {
+        { 0.3f, -1.1f, 2.0f },
+        { -0.7f, 0.4f, -0.2f },
+        { Pi / 2.0f, 0.0f, 0.0f },
+        { 0.0f, Pi / 2.0f, 0.0f },
+        { 0.0f, 0.0f, Pi / 2.0f },
+    };
+
+    for (const Float3& rotation : rotations) {
+        float cp = std::cos(rotation.x), sp = std::sin(rotation.x);
+        float cy = std::cos(rotation.y), sy = std::sin(rotation.y);
+        float cr = std::cos(rotation.z), sr = std::sin(rotation.z);
+        Float4x4 roll = MakeIdentity();
+        roll.m[0][0] = cr; roll.m[0][1] = sr; roll.m[1][0] = -sr; roll.m[1][1] = cr;
+        Float4x4 pitch = MakeIdentity();
+        pitch.m[1][1] = cp; pitch.m[1][2] = sp; pitch.m[2][1] = -sp; pitch.m[2][2] = cp;
+        Float4x4 yaw = MakeIdentity();
+        yaw.m[0][0] = cy; yaw.m[0][2] = -sy; yaw.m[2][0] = sy; yaw.m[2][2] = cy;
+
+        Float4x4 expected = Multiply(Multiply(roll, pitch), yaw);
+        CHECK(Near(ComposeWorldMatrix({ { 0.0f, 0.0f, 0.0f }, rotation, { 1.0f, 1.0f, 1.0f } }), expected));
+    }
+}
+
+TEST(Transform, ComposeAppliesScaleRotationTranslation) {
+    Transform transform = { { 1.0f, 2.0f, 3.0f }, { 0.0f, Pi / 2.0f, 0.0f }, { 2.0f, 2.0f, 2.0f } };
+    Float4x4 world = ComposeWorldMatrix(transform);
+
+    // +X scaled to 2, yawed a quarter turn to -Z, then translated.
+    CHECK(Near(TransformPoint({ 1.0f, 0.0f, 0.0f }, world), { 1.0f, 2.0f, 1.0f }));
+    CHECK(Near(TransformPoint({ 0.0f, 0.0f, 0.0f }, world), transform.position));
+}